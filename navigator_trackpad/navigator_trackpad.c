@@ -9,8 +9,11 @@
 #include "digitizer.h"
 
 // Strong override: called once during keyboard_post_init_quantum().
+// Only kicks off the staged sensor init; digitizer_touchpad_task() drives it
+// to completion so boot isn't held up by the sensor's settle time.
 void digitizer_touchpad_init(void) {
-    navigator_trackpad_device_init();
+    navigator_trackpad_lut_load();
+    navigator_trackpad_init_start();
 }
 
 // Strong override: called from keyboard_task() each iteration.
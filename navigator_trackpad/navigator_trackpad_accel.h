@@ -0,0 +1,75 @@
+// Copyright 2026 ZSA Technology Labs, Inc <contact@zsa.io>
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// Pure, host-testable pointer acceleration for the mouse-fallback path.
+//
+// The curve is out = sensitivity * |delta|^acceleration, the same as before,
+// but both parameters are compile-time constants and the per-frame delta is
+// a bounded integer, so the whole curve is folded into a table when the
+// firmware is built: NT_ACCEL_INIT() expands to NT_ACCEL_TABLE_SIZE Q8.8
+// entries indexed by |delta|, each one a constant expression (GCC folds
+// __builtin_powf of constants). The hot path is one lookup per axis, with no
+// libm call and no float.
+//
+// Deltas past the table use |d|^a = 4^a * (|d|/4)^a: the delta is scaled
+// down by 4 or 16 into the table, interpolated across the dropped bits and
+// scaled back up by the folded 4^a or 16^a, which keeps fast flicks on the
+// curve up to NT_ACCEL_MAX_DELTA.
+//
+// Entries are rounded to the nearest 1/256 and held in 32 bits, so the curve
+// keeps climbing at any sensitivity the settings document. NT_ACCEL_FITS()
+// checks at compile time that the whole range, out to NT_ACCEL_MAX_DELTA,
+// stays below NT_ACCEL_Q8_MAX; entries past it would saturate there.
+
+#pragma once
+
+#include <stdint.h>
+
+#define NT_ACCEL_TABLE_SIZE 256
+#define NT_ACCEL_MAX_DELTA (16 * (NT_ACCEL_TABLE_SIZE - 1) - 1)
+#define NT_ACCEL_Q8_MAX 0x7FFFFF80  // largest Q8.8 value exact in a float, under INT32_MAX
+
+#define _NT_ACCEL_F(n, sens, accel) ((sens) * __builtin_powf((float)(n), (accel)) * 256.0f)
+#define NT_ACCEL_Q8(n, sens, accel)                                                                                   \
+    ((uint32_t)(_NT_ACCEL_F(n, sens, accel) >= (float)NT_ACCEL_Q8_MAX ? (float)NT_ACCEL_Q8_MAX                         \
+                                                                      : _NT_ACCEL_F(n, sens, accel) + 0.5f))
+
+// True when the curve stays inside Q8.8 int32 up to NT_ACCEL_MAX_DELTA, so no
+// entry saturates and the scaled lookups cannot overflow. For _Static_assert.
+#define NT_ACCEL_FITS(sens, accel) (_NT_ACCEL_F(NT_ACCEL_MAX_DELTA, sens, accel) < (float)NT_ACCEL_Q8_MAX)
+
+#define _NT_ACCEL_ROW4(b, s, a) NT_ACCEL_Q8((b), s, a), NT_ACCEL_Q8((b) + 1, s, a), NT_ACCEL_Q8((b) + 2, s, a), NT_ACCEL_Q8((b) + 3, s, a)
+#define _NT_ACCEL_ROW16(b, s, a) _NT_ACCEL_ROW4((b), s, a), _NT_ACCEL_ROW4((b) + 4, s, a), _NT_ACCEL_ROW4((b) + 8, s, a), _NT_ACCEL_ROW4((b) + 12, s, a)
+#define _NT_ACCEL_ROW64(b, s, a) _NT_ACCEL_ROW16((b), s, a), _NT_ACCEL_ROW16((b) + 16, s, a), _NT_ACCEL_ROW16((b) + 32, s, a), _NT_ACCEL_ROW16((b) + 48, s, a)
+
+typedef struct {
+    uint32_t q8[NT_ACCEL_TABLE_SIZE];  // sensitivity * n^accel, Q8.8
+    uint32_t step_q8[2];               // 4^accel and 16^accel, Q8
+} nt_accel_t;
+
+// Initializer for an nt_accel_t.
+#define NT_ACCEL_INIT(sens, accel)                                                                              \
+    {                                                                                                           \
+        {_NT_ACCEL_ROW64(0, sens, accel), _NT_ACCEL_ROW64(64, sens, accel), _NT_ACCEL_ROW64(128, sens, accel),  \
+         _NT_ACCEL_ROW64(192, sens, accel)},                                                                    \
+        {(uint32_t)(__builtin_powf(4.0f, (accel)) * 256.0f + 0.5f), (uint32_t)(__builtin_powf(16.0f, (accel)) * 256.0f + 0.5f)} \
+    }
+
+// Accelerated delta in Q8.8 counts; |delta| must not exceed NT_ACCEL_MAX_DELTA.
+static inline int32_t nt_accel_q8(const nt_accel_t *a, int16_t delta) {
+    uint32_t mag = delta < 0 ? (uint32_t)-delta : (uint32_t)delta;
+    int32_t  q;
+    if (mag < NT_ACCEL_TABLE_SIZE) {
+        q = a->q8[mag];
+    } else {
+        uint8_t  level = mag < 4 * (NT_ACCEL_TABLE_SIZE - 1) ? 0 : 1;
+        uint8_t  shift = 2 + 2 * level;
+        uint32_t m     = mag >> shift;
+        uint32_t r     = mag & ((1u << shift) - 1);
+        // table[m] + (table[m + 1] - table[m]) * r / 2^shift, kept << shift
+        uint64_t lo = a->q8[m], hi = a->q8[m + 1];
+        uint64_t v  = (lo << shift) + (hi - lo) * r;
+        q           = (int32_t)((v * a->step_q8[level]) >> (shift + 8));
+    }
+    return delta < 0 ? -q : q;
+}
@@ -5,6 +5,7 @@
 // Shared by both mouse and PTP implementations
 
 #include <stdint.h>
+#include <string.h>
 #include <sys/types.h>
 #include "navigator_trackpad_common.h"
 #include "i2c_master.h"
@@ -15,100 +16,258 @@
 static uint16_t current_cpi  = DEFAULT_CPI_TICK;
 bool            trackpad_init = false;
 
-// I2C communication functions
-i2c_status_t cirque_gen6_read_report(uint8_t *data, uint16_t cnt) {
-    i2c_status_t res = i2c_receive(NAVIGATOR_TRACKPAD_ADDRESS, data, cnt, NAVIGATOR_TRACKPAD_TIMEOUT);
-    if (res != I2C_STATUS_SUCCESS) {
-        return res;
+static navigator_trackpad_error_stats_t error_stats = {0};
+
+// Asynchronous transaction state. A single transfer slot: the bus operation
+// runs inside cgen6_xfer_start_*(), its outcome is parked here until collected,
+// and the sensor's turnaround is tracked as a deadline rather than slept off.
+typedef enum {
+    CGEN6_XFER_KIND_REPORT,
+    CGEN6_XFER_KIND_HEADER,
+    CGEN6_XFER_KIND_READ,
+    CGEN6_XFER_KIND_PROBE,  // a memory read issued by navigator_trackpad_probe_start()
+    CGEN6_XFER_KIND_WRITE,
+} cgen6_xfer_kind_t;
+
+static struct {
+    cgen6_xfer_kind_t kind;
+    bool              ready;     // result waiting for cgen6_xfer_collect()
+    bool              settling;  // turnaround deadline armed
+    bool              fast_read;
+    uint8_t           result;    // CGEN6_* code
+    uint16_t          cnt;
+    uint16_t          guard_us;
+    uint32_t          issued_at;
+    uint8_t           buf[CGEN6_XFER_MAX_DATA + 9];
+} xfer = {0};
+
+// The QMK timer only counts whole milliseconds, so a turnaround of N us is
+// considered elapsed once strictly more than ceil(N / 1000) ticks have passed.
+// That guarantees at least the required idle time regardless of where in a
+// tick the transfer was issued.
+static bool xfer_guard_elapsed(void) {
+    if (xfer.guard_us == 0) {
+        return true;
     }
-    wait_us(cnt * 15);
-    return res;
+    return timer_elapsed32(xfer.issued_at) > (uint32_t)((xfer.guard_us + 999) / 1000);
 }
 
-void cirque_gen6_clear(void) {
-    uint8_t buf[CGEN6_MAX_PACKET_SIZE];
-    for (uint8_t i = 0; i < 5; i++) {
-        wait_ms(1);
-        if (cirque_gen6_read_report(buf, CGEN6_MAX_PACKET_SIZE) != I2C_STATUS_SUCCESS) {
-            break;
-        }
-    }
+static bool xfer_can_start(uint16_t cnt) {
+    return cnt <= CGEN6_XFER_MAX_DATA && cgen6_xfer_poll() == CGEN6_XFER_IDLE;
 }
 
-uint8_t cirque_gen6_read_memory(uint32_t addr, uint8_t *data, uint16_t cnt, bool fast_read) {
-    uint8_t  cksum = 0;
-    uint8_t  res   = CGEN6_SUCCESS;
-    uint8_t  len[2];
-    uint16_t read = 0;
-
-    uint8_t preamble[8] = {0x01, 0x09, (uint8_t)(addr & (uint32_t)0x000000FF), (uint8_t)((addr & 0x0000FF00) >> 8), (uint8_t)((addr & 0x00FF0000) >> 16), (uint8_t)((addr & 0xFF000000) >> 24), (uint8_t)(cnt & 0x00FF), (uint8_t)((cnt & 0xFF00) >> 8)};
+static void count_bus_error(i2c_status_t status) {
+    if (status == I2C_STATUS_TIMEOUT) {
+        error_stats.timeouts++;
+    } else {
+        error_stats.nacks++;
+    }
+}
 
-    // Read the length of the data + 3 bytes (first 2 bytes for the length and the last byte for the checksum)
-    // Create a buffer to store the data
-    uint8_t buf[cnt + 3];
-    if (i2c_transmit_and_receive(NAVIGATOR_TRACKPAD_ADDRESS, preamble, 8, buf, cnt + 3, NAVIGATOR_TRACKPAD_TIMEOUT) != I2C_STATUS_SUCCESS) {
-        res |= CGEN6_I2C_FAILED;
+static void xfer_issued(cgen6_xfer_kind_t kind, uint16_t cnt, uint16_t guard_us, i2c_status_t status) {
+    xfer.kind      = kind;
+    xfer.cnt       = cnt;
+    xfer.guard_us  = guard_us;
+    xfer.result    = status == I2C_STATUS_SUCCESS ? CGEN6_SUCCESS : CGEN6_I2C_FAILED;
+    xfer.issued_at = timer_read32();
+    xfer.ready     = true;
+    xfer.settling  = true;
+    if (status != I2C_STATUS_SUCCESS) {
+        count_bus_error(status);
         trackpad_init = false;
+        cirque_gen6_invalidate_config();
     }
+}
 
-    // Read the data length
-    for (uint8_t i = 0; i < 2; i++) {
-        cksum += len[i] = buf[i];
-        read++;
+bool cgen6_xfer_start_report(uint16_t cnt) {
+    if (!xfer_can_start(cnt)) {
+        return false;
     }
+    i2c_status_t res = i2c_receive(NAVIGATOR_TRACKPAD_ADDRESS, xfer.buf, cnt, NAVIGATOR_TRACKPAD_TIMEOUT);
+    // A failed read never reaches the sensor's report logic, so there is no
+    // turnaround to honour (matches the old early return before wait_us()).
+    xfer_issued(CGEN6_XFER_KIND_REPORT, cnt, res == I2C_STATUS_SUCCESS ? cnt * CGEN6_REPORT_BYTE_GUARD_US : 0, res);
+    return true;
+}
 
-    // Populate the data buffer
-    for (uint16_t i = 2; i < cnt + 2; i++) {
-        cksum += data[i - 2] = buf[i];
-        read++;
+bool cgen6_xfer_start_report_header(void) {
+    if (!xfer_can_start(2)) {
+        return false;
     }
+    i2c_status_t res = i2c_receive(NAVIGATOR_TRACKPAD_ADDRESS, xfer.buf, 2, NAVIGATOR_TRACKPAD_TIMEOUT);
+    // Collected as a report, the header alone decodes as the empty packet.
+    xfer.buf[2] = 0;
+    xfer_issued(CGEN6_XFER_KIND_HEADER, 2, res == I2C_STATUS_SUCCESS ? 2 * CGEN6_REPORT_BYTE_GUARD_US : 0, res);
+    return true;
+}
 
-    if (!fast_read) {
-        // Check the checksum
-        if (cksum != buf[read]) {
-            res |= CGEN6_CKSUM_FAILED;
-        }
-
-        // Check the length (incremented first to account for the checksum)
-        if (++read != (len[0] | (len[1] << 8))) {
-            res |= CGEN6_LEN_MISMATCH;
-        }
+bool cgen6_xfer_take_queued_header(void) {
+    if (!xfer.ready || xfer.kind != CGEN6_XFER_KIND_HEADER || xfer.result != CGEN6_SUCCESS ||
+        (xfer.buf[0] | (xfer.buf[1] << 8)) < 3) {
+        return false;
+    }
+    xfer.ready = false;
+    return true;
+}
 
-        wait_ms(1);
-    } else {
-        wait_us(250);
+static bool xfer_start_read(cgen6_xfer_kind_t kind, uint32_t addr, uint16_t cnt, bool fast_read) {
+    if (!xfer_can_start(cnt)) {
+        return false;
     }
+    uint8_t preamble[8] = {0x01, 0x09, (uint8_t)(addr & (uint32_t)0x000000FF), (uint8_t)((addr & 0x0000FF00) >> 8), (uint8_t)((addr & 0x00FF0000) >> 16), (uint8_t)((addr & 0xFF000000) >> 24), (uint8_t)(cnt & 0x00FF), (uint8_t)((cnt & 0xFF00) >> 8)};
 
-    return res;
+    // Response is the length of the data + 3 bytes (first 2 bytes for the
+    // length and the last byte for the checksum)
+    i2c_status_t res = i2c_transmit_and_receive(NAVIGATOR_TRACKPAD_ADDRESS, preamble, 8, xfer.buf, cnt + 3, NAVIGATOR_TRACKPAD_TIMEOUT);
+    xfer.fast_read = fast_read;
+    xfer_issued(kind, cnt, fast_read ? CGEN6_FAST_READ_GUARD_US : CGEN6_MEMORY_GUARD_US, res);
+    return true;
 }
 
-uint8_t cirque_gen6_write_memory(uint32_t addr, uint8_t *data, uint16_t cnt) {
-    uint8_t res   = CGEN6_SUCCESS;
+bool cgen6_xfer_start_read(uint32_t addr, uint16_t cnt, bool fast_read) {
+    return xfer_start_read(CGEN6_XFER_KIND_READ, addr, cnt, fast_read);
+}
+
+bool cgen6_xfer_start_write(uint32_t addr, const uint8_t *data, uint16_t cnt) {
+    if (!xfer_can_start(cnt)) {
+        return false;
+    }
     uint8_t cksum = 0, i = 0;
     uint8_t preamble[8] = {0x00, 0x09, (uint8_t)(addr & 0x000000FF), (uint8_t)((addr & 0x0000FF00) >> 8), (uint8_t)((addr & 0x00FF0000) >> 16), (uint8_t)((addr & 0xFF000000) >> 24), (uint8_t)(cnt & 0x00FF), (uint8_t)((cnt & 0xFF00) >> 8)};
 
-    uint8_t buf[cnt + 9];
     // Calculate the checksum
     for (; i < 8; i++) {
-        cksum += buf[i] = preamble[i];
+        cksum += xfer.buf[i] = preamble[i];
     }
 
     for (i = 0; i < cnt; i++) {
-        cksum += buf[i + 8] = data[i];
+        cksum += xfer.buf[i + 8] = data[i];
     }
 
-    buf[cnt + 8] = cksum;
+    xfer.buf[cnt + 8] = cksum;
 
-    if (i2c_transmit(NAVIGATOR_TRACKPAD_ADDRESS, buf, cnt + 9, NAVIGATOR_TRACKPAD_TIMEOUT) != I2C_STATUS_SUCCESS) {
-        res |= CGEN6_I2C_FAILED;
-        trackpad_init = false;
+    i2c_status_t res = i2c_transmit(NAVIGATOR_TRACKPAD_ADDRESS, xfer.buf, cnt + 9, NAVIGATOR_TRACKPAD_TIMEOUT);
+    xfer_issued(CGEN6_XFER_KIND_WRITE, cnt, CGEN6_MEMORY_GUARD_US, res);
+    return true;
+}
+
+cgen6_xfer_state_t cgen6_xfer_poll(void) {
+    if (xfer.ready) {
+        return CGEN6_XFER_READY;
+    }
+    if (xfer.settling) {
+        if (!xfer_guard_elapsed()) {
+            return CGEN6_XFER_SETTLING;
+        }
+        xfer.settling = false;
+    }
+    return CGEN6_XFER_IDLE;
+}
+
+uint8_t cgen6_xfer_collect(uint8_t *data, uint16_t cnt) {
+    if (!xfer.ready) {
+        return CGEN6_I2C_FAILED;
+    }
+    xfer.ready = false;
+    if (cnt > xfer.cnt) {
+        cnt = xfer.cnt;
+    }
+
+    uint8_t res = xfer.result;
+    switch (xfer.kind) {
+        case CGEN6_XFER_KIND_REPORT:
+        case CGEN6_XFER_KIND_HEADER:
+            if (data) {
+                memcpy(data, xfer.buf, cnt);
+            }
+            break;
+
+        case CGEN6_XFER_KIND_READ:
+        case CGEN6_XFER_KIND_PROBE: {
+            uint8_t  cksum = 0;
+            uint16_t read  = 0;
+
+            // Read the data length, then the data itself
+            for (uint16_t i = 0; i < xfer.cnt + 2; i++) {
+                cksum += xfer.buf[i];
+                read++;
+            }
+            if (data) {
+                memcpy(data, &xfer.buf[2], cnt);
+            }
+
+            // A failed transfer left the buffer stale: it is already counted
+            // as a NACK or timeout, not as a bad checksum or length.
+            if (!xfer.fast_read && res == CGEN6_SUCCESS) {
+                // Check the checksum
+                if (cksum != xfer.buf[read]) {
+                    res |= CGEN6_CKSUM_FAILED;
+                    error_stats.cksum_failures++;
+                }
+
+                // Check the length (incremented first to account for the checksum)
+                if (++read != (xfer.buf[0] | (xfer.buf[1] << 8))) {
+                    res |= CGEN6_LEN_MISMATCH;
+                    error_stats.len_mismatches++;
+                }
+            }
+            break;
+        }
+
+        case CGEN6_XFER_KIND_WRITE:
+            break;
     }
+    return res;
+}
 
-    wait_ms(1);
+void cgen6_xfer_flush(void) {
+    // An uncollected result belongs to a caller that has given up the bus.
+    xfer.ready = false;
+    if (xfer.settling) {
+        wait_us(xfer.guard_us);
+        xfer.settling = false;
+    }
+}
 
+// Blocking path shared by the wrappers below: wait for the bus, run the
+// transfer, collect it and sit out the turnaround, exactly like the original
+// synchronous driver did.
+static uint8_t xfer_blocking_collect(bool started, uint8_t *data, uint16_t cnt) {
+    if (!started) {
+        return CGEN6_I2C_FAILED;
+    }
+    uint8_t res = cgen6_xfer_collect(data, cnt);
+    cgen6_xfer_flush();
     return res;
 }
 
+// I2C communication functions
+i2c_status_t cirque_gen6_read_report(uint8_t *data, uint16_t cnt) {
+    cgen6_xfer_flush();
+    uint8_t res = xfer_blocking_collect(cgen6_xfer_start_report(cnt), data, cnt);
+    return res == CGEN6_SUCCESS ? I2C_STATUS_SUCCESS : I2C_STATUS_ERROR;
+}
+
+void cirque_gen6_clear(void) {
+    uint8_t buf[CGEN6_MAX_PACKET_SIZE];
+    for (uint8_t i = 0; i < 5; i++) {
+        wait_ms(1);
+        if (cirque_gen6_read_report(buf, CGEN6_MAX_PACKET_SIZE) != I2C_STATUS_SUCCESS) {
+            break;
+        }
+    }
+}
+
+uint8_t cirque_gen6_read_memory(uint32_t addr, uint8_t *data, uint16_t cnt, bool fast_read) {
+    cgen6_xfer_flush();
+    return xfer_blocking_collect(cgen6_xfer_start_read(addr, cnt, fast_read), data, cnt);
+}
+
+uint8_t cirque_gen6_write_memory(uint32_t addr, uint8_t *data, uint16_t cnt) {
+    cgen6_xfer_flush();
+    return xfer_blocking_collect(cgen6_xfer_start_write(addr, data, cnt), NULL, 0);
+}
+
 // Register access functions
 uint8_t cirque_gen6_read_reg(uint32_t addr, bool fast_read) {
     uint8_t data;
@@ -154,58 +313,144 @@ uint8_t cirque_gen6_write_reg_32(uint32_t addr, uint32_t data) {
     return cirque_gen6_write_memory(addr, buf, 4);
 }
 
+// Shadow of the configuration registers. Each register is read from the
+// sensor at most once while the shadow is valid; the config helpers below
+// edit the shadow and only touch the bus for registers whose value changed.
+// Between cirque_gen6_config_begin() and cirque_gen6_config_commit() the
+// writes are deferred too, so a sequence of edits to one register costs one
+// read and one write. Any bus failure drops the whole shadow (the sensor may
+// have been unplugged or reset behind our back).
+typedef struct {
+    uint32_t addr;
+    uint8_t  value;
+    bool     valid;
+    bool     dirty;
+} cgen6_shadow_reg_t;
+
+static cgen6_shadow_reg_t shadow_regs[] = {
+    {.addr = CGEN6_FEED_CONFIG4},
+    {.addr = CGEN6_XY_CONFIG},
+    {.addr = CGEN6_SYS_CONFIG1},
+};
+
+static bool    shadow_batching = false;
+static uint8_t shadow_batch_res = CGEN6_SUCCESS;
+
+void cirque_gen6_invalidate_config(void) {
+    for (uint8_t i = 0; i < sizeof(shadow_regs) / sizeof(shadow_regs[0]); i++) {
+        shadow_regs[i].valid = false;
+        shadow_regs[i].dirty = false;
+    }
+}
+
+static cgen6_shadow_reg_t *shadow_find(uint32_t addr) {
+    for (uint8_t i = 0; i < sizeof(shadow_regs) / sizeof(shadow_regs[0]); i++) {
+        if (shadow_regs[i].addr == addr) {
+            return &shadow_regs[i];
+        }
+    }
+    return NULL;
+}
+
+static uint8_t shadow_write_back(cgen6_shadow_reg_t *reg) {
+    uint8_t res = cirque_gen6_write_reg(reg->addr, reg->value);
+    if (res == CGEN6_SUCCESS) {
+        reg->dirty = false;
+    }
+    return res;
+}
+
+// Apply (value & ~clear) | set to a shadowed register, loading it first if
+// the shadow is cold. Writes through immediately unless a batch is open.
+// Fails without touching the bus for a register that is not shadowed.
+static uint8_t shadow_update(uint32_t addr, uint8_t clear, uint8_t set) {
+    cgen6_shadow_reg_t *reg = shadow_find(addr);
+    uint8_t             res = CGEN6_SUCCESS;
+
+    if (!reg) {
+        shadow_batch_res |= CGEN6_I2C_FAILED;
+        return CGEN6_I2C_FAILED;
+    }
+    if (!reg->valid) {
+        res = cirque_gen6_read_memory(reg->addr, &reg->value, 1, false);
+        if (res != CGEN6_SUCCESS) {
+            shadow_batch_res |= res;
+            return res;
+        }
+        reg->valid = true;
+    }
+
+    uint8_t value = (reg->value & ~clear) | set;
+    if (value != reg->value) {
+        reg->value = value;
+        reg->dirty = true;
+    }
+
+    if (!shadow_batching && reg->dirty) {
+        res = shadow_write_back(reg);
+    }
+    shadow_batch_res |= res;
+    return res;
+}
+
+uint8_t cirque_gen6_read_config(uint32_t addr, uint8_t *value) {
+    cgen6_shadow_reg_t *reg = shadow_find(addr);
+    if (!reg) {
+        // Not shadowed: read it from the sensor.
+        return cirque_gen6_read_memory(addr, value, 1, false);
+    }
+    uint8_t res = shadow_update(addr, 0, 0);
+    *value      = reg->value;
+    return res;
+}
+
+void cirque_gen6_config_begin(void) {
+    shadow_batching  = true;
+    shadow_batch_res = CGEN6_SUCCESS;
+}
+
+uint8_t cirque_gen6_config_commit(void) {
+    shadow_batching = false;
+    uint8_t res     = shadow_batch_res;
+    for (uint8_t i = 0; i < sizeof(shadow_regs) / sizeof(shadow_regs[0]) && res == CGEN6_SUCCESS; i++) {
+        if (shadow_regs[i].dirty) {
+            res |= shadow_write_back(&shadow_regs[i]);
+        }
+    }
+    return res;
+}
+
+// Close a batch without writing it: the edits stay dirty in the shadow for a
+// later write-back, and the batch's result is dropped so the next batch
+// starts clean.
+static void config_batch_abort(void) {
+    shadow_batching  = false;
+    shadow_batch_res = CGEN6_SUCCESS;
+}
+
 // Configuration functions
 uint8_t cirque_gen6_set_relative_mode(void) {
-    uint8_t feed_config4 = cirque_gen6_read_reg(CGEN6_FEED_CONFIG4, false);
-    feed_config4 &= 0xF3;
-    return cirque_gen6_write_reg(CGEN6_FEED_CONFIG4, feed_config4);
+    return shadow_update(CGEN6_FEED_CONFIG4, 0x0C, 0x00);
 }
 
 uint8_t cirque_gen6_set_ptp_mode(void) {
-    uint8_t feed_config4 = cirque_gen6_read_reg(CGEN6_FEED_CONFIG4, false);
-    feed_config4 &= 0xF7;
-    feed_config4 |= 0x04;
-    return cirque_gen6_write_reg(CGEN6_FEED_CONFIG4, feed_config4);
+    return shadow_update(CGEN6_FEED_CONFIG4, 0x08, 0x04);
 }
 
 uint8_t cirque_gen6_swap_xy(bool set) {
-    uint8_t xy_config = cirque_gen6_read_reg(CGEN6_XY_CONFIG, false);
-    if (set) {
-        xy_config |= 0x04;
-    } else {
-        xy_config &= ~0x04;
-    }
-    return cirque_gen6_write_reg(CGEN6_XY_CONFIG, xy_config);
+    return shadow_update(CGEN6_XY_CONFIG, set ? 0x00 : 0x04, set ? 0x04 : 0x00);
 }
 
 uint8_t cirque_gen6_invert_y(bool set) {
-    uint8_t xy_config = cirque_gen6_read_reg(CGEN6_XY_CONFIG, false);
-    if (set) {
-        xy_config |= 0x02;
-    } else {
-        xy_config &= ~0x02;
-    }
-    return cirque_gen6_write_reg(CGEN6_XY_CONFIG, xy_config);
+    return shadow_update(CGEN6_XY_CONFIG, set ? 0x00 : 0x02, set ? 0x02 : 0x00);
 }
 
 uint8_t cirque_gen6_invert_x(bool set) {
-    uint8_t xy_config = cirque_gen6_read_reg(CGEN6_XY_CONFIG, false);
-    if (set) {
-        xy_config |= 0x01;
-    } else {
-        xy_config &= ~0x01;
-    }
-    return cirque_gen6_write_reg(CGEN6_XY_CONFIG, xy_config);
+    return shadow_update(CGEN6_XY_CONFIG, set ? 0x00 : 0x01, set ? 0x01 : 0x00);
 }
 
 uint8_t cirque_gen6_enable_logical_scaling(bool set) {
-    uint8_t xy_config = cirque_gen6_read_reg(CGEN6_XY_CONFIG, false);
-    if (set) {
-        xy_config &= ~0x08;
-    } else {
-        xy_config |= 0x08;
-    }
-    return cirque_gen6_write_reg(CGEN6_XY_CONFIG, xy_config);
+    return shadow_update(CGEN6_XY_CONFIG, set ? 0x08 : 0x00, set ? 0x00 : 0x08);
 }
 
 // Motion detection - returns true if data ready, false on no motion or I2C failure
@@ -219,14 +464,9 @@ bool cirque_gen6_has_motion(void) {
     return data != 0;
 }
 
-// Report reading - fills provided report struct. Returns true on valid data, false on I2C failure or no data.
-bool cirque_gen_6_read_report(cgen6_report_t *report) {
-    uint8_t packet[CGEN6_MAX_PACKET_SIZE];
-    if (cirque_gen6_read_report(packet, CGEN6_MAX_PACKET_SIZE) != I2C_STATUS_SUCCESS) {
-        trackpad_init = false;
-        return false;
-    }
-
+// Decode a raw report packet into the report struct. Returns false for an
+// unknown or empty report.
+bool cgen6_decode_report(const uint8_t *packet, cgen6_report_t *report) {
     uint8_t report_id = packet[2];
 
     // PTP mode report
@@ -261,19 +501,100 @@ bool cirque_gen_6_read_report(cgen6_report_t *report) {
     return false;
 }
 
-// Device initialization - returns true on success, false on failure
-void navigator_trackpad_device_init(void) {
-    i2c_init();
-    i2c_status_t status = i2c_ping_address(NAVIGATOR_TRACKPAD_ADDRESS, NAVIGATOR_TRACKPAD_TIMEOUT);
-    if (status != I2C_STATUS_SUCCESS) {
+// Report reading - fills provided report struct. Returns true on valid data, false on I2C failure or no data.
+bool cirque_gen_6_read_report(cgen6_report_t *report) {
+    uint8_t packet[CGEN6_MAX_PACKET_SIZE];
+    if (cirque_gen6_read_report(packet, CGEN6_MAX_PACKET_SIZE) != I2C_STATUS_SUCCESS) {
         trackpad_init = false;
-        return;
+        return false;
+    }
+    return cgen6_decode_report(packet, report);
+}
+
+// Decodes straight out of the transfer buffer, which stays put until the next
+// transfer is issued.
+bool cirque_gen_6_collect_report(cgen6_report_t *report) {
+    if (cgen6_xfer_collect(NULL, 0) != CGEN6_SUCCESS) {
+        trackpad_init = false;
+        return false;
     }
-    cirque_gen6_clear();
-    wait_ms(50);
+    return cgen6_decode_report(xfer.buf, report);
+}
+
+#ifdef NAVIGATOR_TRACKPAD_DR_PIN
+bool navigator_trackpad_data_ready(void) {
+#    if NAVIGATOR_TRACKPAD_DR_ACTIVE_LOW == TRUE
+    return !gpio_read_pin(NAVIGATOR_TRACKPAD_DR_PIN);
+#    else
+    return gpio_read_pin(NAVIGATOR_TRACKPAD_DR_PIN);
+#    endif
+}
 
-    // Dump sensor info to the console if needed, just set NAVIGATOR_TRACKPAD_DEBUG to 1 in your config.h
- #if defined(NAVIGATOR_TRACKPAD_DEBUG)
+bool navigator_trackpad_probe_start(void) {
+    return xfer_start_read(CGEN6_XFER_KIND_PROBE, CGEN6_FEED_CONFIG4, 1, false);
+}
+
+bool navigator_trackpad_probe_take(void) {
+    if (!xfer.ready || xfer.kind != CGEN6_XFER_KIND_PROBE) {
+        return false;
+    }
+    uint8_t             value;
+    uint8_t             res = cgen6_xfer_collect(&value, 1);
+    cgen6_shadow_reg_t *reg = shadow_find(CGEN6_FEED_CONFIG4);
+    if (res == CGEN6_SUCCESS && (reg->valid ? value == reg->value : (value & 0x0C) == 0x04)) {
+        return true;
+    }
+    // Gone, or power-cycled back to its defaults: hand it to recovery.
+    trackpad_init = false;
+    cirque_gen6_invalidate_config();
+    return true;
+}
+#endif
+
+// Device initialization, split into stages that each do at most one bus
+// transfer. navigator_trackpad_init_step() runs whichever stage is due and
+// returns, so a probe or hot-plug re-init never stalls the keyboard for more
+// than a single transaction; the sensor's settle delays are deadlines.
+//
+// The config registers are loaded straight after the ping. If they already
+// hold the desired configuration (a keyboard reset or USB re-enumeration with
+// the sensor still powered), init ends there: no drain, no settle, no writes.
+// Otherwise it falls back to the full drain/settle/configure sequence.
+typedef enum {
+    INIT_IDLE,
+    INIT_PING,      // i2c_init + address ping
+    INIT_CLEAR,     // drain stale packets from the sensor FIFO
+    INIT_SETTLE,    // let the sensor settle after the drain
+    INIT_LOAD,      // fill the config shadow, one register per transfer
+    INIT_WRITE,     // write back changed registers, one per transfer
+} init_stage_t;
+
+#define INIT_CLEAR_READS 5
+#define INIT_CLEAR_GAP_MS 1
+#define INIT_SETTLE_MS 50
+
+// Registers the init sequence configures (shadowed, see above).
+static const uint32_t init_regs[] = {CGEN6_FEED_CONFIG4, CGEN6_XY_CONFIG};
+
+static struct {
+    init_stage_t        stage;
+    bool                resync;     // skip the drain and settle (see recovery below)
+    bool                drained;    // drain/settle done or skipped; LOAD goes on to WRITE
+    uint8_t             clear_reads;
+    uint32_t            stage_time;
+    cgen6_shadow_reg_t *in_flight;  // register being loaded or written
+} init_state = {.stage = INIT_IDLE};
+
+static void init_enter(init_stage_t stage) {
+    init_state.stage      = stage;
+    init_state.stage_time = timer_read32();
+    init_state.in_flight  = NULL;
+}
+
+#if defined(NAVIGATOR_TRACKPAD_DEBUG)
+// Dump sensor info to the console. Debug-only, so it keeps the simple
+// blocking register helpers.
+static void init_dump_sensor_info(void) {
     uint8_t  hardwareId  = cirque_gen6_read_reg(CGEN6_HARDWARE_ID, false);
     uint8_t  firmwareId  = cirque_gen6_read_reg(CGEN6_FIRMWARE_ID, false);
     uint16_t vendorId    = cirque_gen6_read_reg_16(CGEN6_VENDOR_ID);
@@ -296,22 +617,261 @@ void navigator_trackpad_device_init(void) {
     printf("Touchpad Uncommitted Version: %s\n", uncommittedVersion ? "true" : "false");
     printf("Touchpad Branch Version: %s\n", branchVersion ? "true" : "false");
     printf("Touchpad Developer ID: %d\n", developerId);
+}
 #endif
 
-    uint8_t res = CGEN6_SUCCESS;
-    res = cirque_gen6_set_ptp_mode();
-
-    if (res != CGEN6_SUCCESS) {
-        trackpad_init = false;
-        return;
+// Fault recovery ladder. A failed report read is retried at once (RETRY); if
+// the retry fails too, the bus is re-synced with a short init that pings the
+// sensor and re-checks its configuration without draining or settling
+// (RESYNC); only if that fails does the full init run again, on an
+// exponential backoff from NAVIGATOR_TRACKPAD_RECOVERY_BACKOFF_MIN_MS up to
+// the NAVIGATOR_TRACKPAD_PROBE_INTERVAL_MS slow probe (REINIT).
+typedef enum {
+    RECOVERY_NONE,
+    RECOVERY_RETRY,
+    RECOVERY_RESYNC,
+    RECOVERY_REINIT,
+} recovery_stage_t;
+
+static struct {
+    recovery_stage_t stage;
+    bool             faulted;  // in an episode that began with a fault in service
+    uint16_t         backoff_ms;
+    uint32_t         last_attempt;
+} recovery = {.stage = RECOVERY_NONE};
+
+static void init_finish(bool ok) {
+    init_state.stage = INIT_IDLE;
+    trackpad_init    = ok;
+    if (ok) {
+#if defined(NAVIGATOR_TRACKPAD_DEBUG)
+        if (!init_state.resync) {
+            init_dump_sensor_info();
+        }
+#endif
+        if (recovery.faulted) {
+            error_stats.recoveries++;
+        }
+        recovery.stage      = RECOVERY_NONE;
+        recovery.faulted    = false;
+        recovery.backoff_ms = 0;
+    } else {
+        if (recovery.stage != RECOVERY_REINIT || recovery.backoff_ms == 0) {
+            recovery.backoff_ms = NAVIGATOR_TRACKPAD_RECOVERY_BACKOFF_MIN_MS;
+        } else if (recovery.backoff_ms < NAVIGATOR_TRACKPAD_PROBE_INTERVAL_MS) {
+            recovery.backoff_ms *= 2;
+            if (recovery.backoff_ms > NAVIGATOR_TRACKPAD_PROBE_INTERVAL_MS) {
+                recovery.backoff_ms = NAVIGATOR_TRACKPAD_PROBE_INTERVAL_MS;
+            }
+        }
+        recovery.stage        = RECOVERY_REINIT;
+        recovery.last_attempt = timer_read32();
     }
+}
 
+// Desired sensor configuration, applied to the (warm) shadow.
+static void init_apply_config(void) {
+    cirque_gen6_config_begin();
+    cirque_gen6_set_ptp_mode();
     cirque_gen6_swap_xy(true);
     cirque_gen6_invert_x(true);
     cirque_gen6_invert_y(true);
     cirque_gen6_enable_logical_scaling(false);  // Disable scaling for raw coordinates
+    config_batch_abort();                       // leave the edits dirty for INIT_WRITE
+}
+
+static void init_begin(bool resync) {
+    // Any report still waiting for collection belongs to the session that
+    // just failed; drop it without sitting out its turnaround.
+    xfer.ready         = false;
+    trackpad_init      = false;
+    init_state.resync  = resync;
+    init_state.drained = resync;
+    init_enter(INIT_PING);
+}
+
+void navigator_trackpad_init_start(void) {
+    init_begin(false);
+}
+
+bool navigator_trackpad_init_in_progress(void) {
+    return init_state.stage != INIT_IDLE;
+}
+
+bool navigator_trackpad_init_step(void) {
+    if (init_state.stage == INIT_IDLE) {
+        return false;
+    }
+
+    // Finish the transfer issued by the previous step first.
+    cgen6_xfer_state_t xs = cgen6_xfer_poll();
+    if (xs == CGEN6_XFER_READY) {
+        cgen6_shadow_reg_t *reg = init_state.in_flight;
+        uint8_t             res = cgen6_xfer_collect(reg && init_state.stage == INIT_LOAD ? &reg->value : NULL, 1);
+        init_state.in_flight    = NULL;
+        switch (init_state.stage) {
+            case INIT_CLEAR:
+                init_state.stage_time = timer_read32();
+                if (res != CGEN6_SUCCESS || ++init_state.clear_reads >= INIT_CLEAR_READS) {
+                    // The drain is best-effort, as before: a failed read just ends it.
+                    init_enter(INIT_SETTLE);
+                }
+                return true;
+            case INIT_LOAD:
+            case INIT_WRITE:
+                if (res != CGEN6_SUCCESS) {
+                    cirque_gen6_invalidate_config();
+                    if (!init_state.drained) {
+                        // The fingerprint read can trip over stale packets
+                        // still queued in the FIFO: drain and reload.
+                        init_enter(INIT_CLEAR);
+                        return true;
+                    }
+                    init_finish(false);
+                    return false;
+                }
+                if (init_state.stage == INIT_LOAD) {
+                    reg->valid = true;
+                } else {
+                    reg->dirty = false;
+                }
+                return true;
+            default:
+                return true;
+        }
+    }
+    if (xs != CGEN6_XFER_IDLE) {
+        return true;
+    }
 
+    switch (init_state.stage) {
+        case INIT_PING:
+            // The sensor may have been power-cycled since the shadow was filled.
+            cirque_gen6_invalidate_config();
+            i2c_init();
+#ifdef NAVIGATOR_TRACKPAD_DR_PIN
+#    if NAVIGATOR_TRACKPAD_DR_ACTIVE_LOW == TRUE
+            gpio_set_pin_input_high(NAVIGATOR_TRACKPAD_DR_PIN);
+#    else
+            gpio_set_pin_input(NAVIGATOR_TRACKPAD_DR_PIN);
+#    endif
+#endif
+            i2c_status_t ping = i2c_ping_address(NAVIGATOR_TRACKPAD_ADDRESS, NAVIGATOR_TRACKPAD_TIMEOUT);
+            if (ping != I2C_STATUS_SUCCESS) {
+                count_bus_error(ping);
+                init_finish(false);
+                return false;
+            }
+            init_state.clear_reads = 0;
+            init_enter(INIT_LOAD);
+            return true;
+
+        case INIT_CLEAR:
+            if (timer_elapsed32(init_state.stage_time) >= INIT_CLEAR_GAP_MS) {
+                cgen6_xfer_start_report(CGEN6_MAX_PACKET_SIZE);
+            }
+            return true;
+
+        case INIT_SETTLE:
+            if (timer_elapsed32(init_state.stage_time) < INIT_SETTLE_MS) {
+                return true;
+            }
+            init_state.drained = true;
+            init_enter(INIT_LOAD);
+            return true;
+
+        case INIT_LOAD:
+            for (uint8_t i = 0; i < sizeof(init_regs) / sizeof(init_regs[0]); i++) {
+                cgen6_shadow_reg_t *reg = shadow_find(init_regs[i]);
+                if (!reg->valid) {
+                    init_state.in_flight = reg;
+                    cgen6_xfer_start_read(reg->addr, 1, false);
+                    return true;
+                }
+            }
+            init_apply_config();
+            if (!init_state.drained) {
+                for (uint8_t i = 0; i < sizeof(shadow_regs) / sizeof(shadow_regs[0]); i++) {
+                    if (shadow_regs[i].dirty) {
+                        init_enter(INIT_CLEAR);
+                        return true;
+                    }
+                }
+                // Warm boot: the sensor kept its configuration.
+                init_finish(true);
+                return false;
+            }
+            init_enter(INIT_WRITE);
+            return true;
+
+        case INIT_WRITE:
+            for (uint8_t i = 0; i < sizeof(shadow_regs) / sizeof(shadow_regs[0]); i++) {
+                if (shadow_regs[i].dirty) {
+                    init_state.in_flight = &shadow_regs[i];
+                    cgen6_xfer_start_write(shadow_regs[i].addr, &shadow_regs[i].value, 1);
+                    return true;
+                }
+            }
+            init_finish(true);
+            return false;
+
+        default:
+            return false;
+    }
+}
+
+bool navigator_trackpad_fault_retry(void) {
+    if (recovery.stage != RECOVERY_NONE) {
+        return false;
+    }
+    recovery.stage   = RECOVERY_RETRY;
+    recovery.faulted = true;
+    error_stats.retries++;
     trackpad_init = true;
+    return true;
+}
+
+void navigator_trackpad_fault_clear(void) {
+    if (recovery.stage == RECOVERY_RETRY) {
+        error_stats.recoveries++;
+        recovery.stage   = RECOVERY_NONE;
+        recovery.faulted = false;
+    }
+}
+
+void navigator_trackpad_recovery_task(void) {
+    if (navigator_trackpad_init_step() || trackpad_init) {
+        return;
+    }
+    if (recovery.stage == RECOVERY_NONE || recovery.stage == RECOVERY_RETRY) {
+        // Lost the sensor in service (or the immediate retry failed): re-sync.
+        recovery.stage   = RECOVERY_RESYNC;
+        recovery.faulted = true;
+        error_stats.resyncs++;
+        init_begin(true);
+        return;
+    }
+    if (timer_elapsed32(recovery.last_attempt) < recovery.backoff_ms) {
+        return;
+    }
+    recovery.last_attempt = timer_read32();
+    init_begin(false);
+}
+
+const navigator_trackpad_error_stats_t *navigator_trackpad_get_error_stats(void) {
+    return &error_stats;
+}
+
+void navigator_trackpad_clear_error_stats(void) {
+    error_stats = (navigator_trackpad_error_stats_t){0};
+}
+
+// Blocking init: runs the staged sequence to completion.
+void navigator_trackpad_device_init(void) {
+    navigator_trackpad_init_start();
+    while (navigator_trackpad_init_step()) {
+        wait_us(100);
+    }
 }
 
 // CPI management
@@ -10,6 +10,41 @@
 #define NAVIGATOR_TRACKPAD_POLL_INTERVAL_MS 5    // Minimum interval between sensor queries
 #define NAVIGATOR_TRACKPAD_PROBE_INTERVAL_MS 1000 // Interval for probing disconnected device
 
+// First re-init backoff after a failed bus re-sync; doubles on each failed
+// attempt up to NAVIGATOR_TRACKPAD_PROBE_INTERVAL_MS.
+#ifndef NAVIGATOR_TRACKPAD_RECOVERY_BACKOFF_MIN_MS
+#    define NAVIGATOR_TRACKPAD_RECOVERY_BACKOFF_MIN_MS 8
+#endif
+
+// Data-ready sampling. Define NAVIGATOR_TRACKPAD_DR_PIN to the GPIO wired to
+// the Cirque's DR output and the task reads the sensor only when it signals a
+// fresh frame, instead of polling every NAVIGATOR_TRACKPAD_POLL_INTERVAL_MS.
+// Leave it undefined to keep the polling path.
+#ifdef NAVIGATOR_TRACKPAD_DR_PIN
+#    ifndef NAVIGATOR_TRACKPAD_DR_ACTIVE_LOW
+#        define NAVIGATOR_TRACKPAD_DR_ACTIVE_LOW TRUE
+#    endif
+// The sensor emits a frame roughly every 8 ms while touched. If DR stays quiet
+// this long while a contact is still tracked, the lift-off packet was lost and
+// the contact is released.
+#    ifndef NAVIGATOR_TRACKPAD_DR_LIFTOFF_TIMEOUT_MS
+#        define NAVIGATOR_TRACKPAD_DR_LIFTOFF_TIMEOUT_MS 25
+#    endif
+#endif
+
+// Length-prefixed report reads (polling mode). Each poll reads only the
+// sensor's 2-byte length header and fetches the full report only when the
+// header says one is queued, so empty polls cost 2 bytes on the bus instead
+// of 17. Not used in DR mode, where DR already says a report is waiting.
+// Off by default: it relies on the sensor keeping a report queued after a
+// read of just its header and sending it whole on the next read, which has
+// not been confirmed on hardware. A sensor that drops the report on any read
+// would lose every frame this way (see test_prefixed_bus_bytes in
+// tests/sim_test.c).
+#ifndef NAVIGATOR_TRACKPAD_LENGTH_PREFIXED_READS
+#    define NAVIGATOR_TRACKPAD_LENGTH_PREFIXED_READS FALSE
+#endif
+
 #ifndef NAVIGATOR_TRACKPAD_ADDRESS
 #    define NAVIGATOR_TRACKPAD_ADDRESS 0x58
 #endif
@@ -137,7 +172,49 @@ typedef struct {
     int8_t         panDelta;      // Used by mouse mode
 } cgen6_report_t;
 
-// Low-level I2C functions
+// Sensor turnaround after each transaction (us). The Gen6 needs this idle time
+// on the bus before it will accept the next transfer.
+#define CGEN6_REPORT_BYTE_GUARD_US 15    // per byte of a raw report read
+#define CGEN6_FAST_READ_GUARD_US 250     // after a fast (unchecked) memory read
+#define CGEN6_MEMORY_GUARD_US 1000       // after a checked memory read or any write
+
+// Largest payload a single asynchronous transfer can carry (register data
+// bytes for memory reads/writes, whole packet for raw report reads).
+#define CGEN6_XFER_MAX_DATA CGEN6_MAX_PACKET_SIZE
+
+// Asynchronous transaction layer.
+//
+// One transfer is in flight at a time. A cgen6_xfer_start_*() call performs the
+// bus operation and returns straight away, without sleeping through the
+// sensor's turnaround time; the caller collects the outcome on a later task
+// tick with cgen6_xfer_collect(). The turnaround is kept as a deadline instead
+// of a busy-wait: cgen6_xfer_poll() reports CGEN6_XFER_SETTLING until it has
+// elapsed, and no new transfer can be issued before then.
+typedef enum {
+    CGEN6_XFER_IDLE,     // bus free, a new transfer may be issued
+    CGEN6_XFER_READY,    // a transfer completed and its result awaits collection
+    CGEN6_XFER_SETTLING, // result collected, sensor turnaround still running
+} cgen6_xfer_state_t;
+
+bool               cgen6_xfer_start_report(uint16_t cnt);
+// Length-prefixed polling in two transfers: read just the 2-byte length
+// header. Once it is READY, cgen6_xfer_take_queued_header() consumes it if it
+// says a report is queued, and the caller then reads the whole report with
+// cgen6_xfer_start_report() when the bus is IDLE again. An empty or failed
+// header is collected like a report read that found nothing.
+bool               cgen6_xfer_start_report_header(void);
+bool               cgen6_xfer_take_queued_header(void);
+bool               cgen6_xfer_start_read(uint32_t addr, uint16_t cnt, bool fast_read);
+bool               cgen6_xfer_start_write(uint32_t addr, const uint8_t *data, uint16_t cnt);
+cgen6_xfer_state_t cgen6_xfer_poll(void);
+// Copies the transfer's payload (report bytes or register data, up to cnt) into
+// data, which may be NULL for writes. Returns a CGEN6_* result code.
+uint8_t            cgen6_xfer_collect(uint8_t *data, uint16_t cnt);
+// Blocking helper: drop any uncollected result and spin out whatever
+// turnaround remains so the bus is idle.
+void               cgen6_xfer_flush(void);
+
+// Low-level I2C functions (blocking wrappers over the transaction layer)
 i2c_status_t cirque_gen6_read_report(uint8_t *data, uint16_t cnt);
 void         cirque_gen6_clear(void);
 uint8_t      cirque_gen6_read_memory(uint32_t addr, uint8_t *data, uint16_t cnt, bool fast_read);
@@ -151,6 +228,16 @@ uint8_t  cirque_gen6_write_reg(uint32_t addr, uint8_t data);
 uint8_t  cirque_gen6_write_reg_16(uint32_t addr, uint16_t data);
 uint8_t  cirque_gen6_write_reg_32(uint32_t addr, uint32_t data);
 
+// Configuration register shadow (FEED_CONFIG4, XY_CONFIG, SYS_CONFIG1).
+// The config functions below edit a RAM copy and only read a register from the
+// sensor when the copy is cold. Wrap several edits in begin/commit to defer the
+// writes and send each changed register once. Bus failures invalidate it.
+// cirque_gen6_read_config() reads any other register straight from the sensor.
+void    cirque_gen6_config_begin(void);
+uint8_t cirque_gen6_config_commit(void);
+void    cirque_gen6_invalidate_config(void);
+uint8_t cirque_gen6_read_config(uint32_t addr, uint8_t *value);
+
 // Configuration functions
 uint8_t cirque_gen6_set_relative_mode(void);
 uint8_t cirque_gen6_set_ptp_mode(void);
@@ -164,9 +251,61 @@ uint8_t cirque_gen6_enable_logical_scaling(bool set);
 bool cirque_gen6_has_motion(void);
 // Reads report data into provided report struct. Returns true on success, false on I2C failure.
 bool cirque_gen_6_read_report(cgen6_report_t *report);
+// Non-blocking counterpart: collects a report issued earlier with
+// cgen6_xfer_start_report(). Same return semantics as cirque_gen_6_read_report.
+bool cirque_gen_6_collect_report(cgen6_report_t *report);
+// Decodes a raw report packet as read off the bus (no I/O; used by the above
+// and by tools/nt_replay.c). Returns false for an unknown or empty report.
+bool cgen6_decode_report(const uint8_t *packet, cgen6_report_t *report);
 
-// Device initialization
+// Device initialization. navigator_trackpad_device_init() blocks until done;
+// the task path instead calls navigator_trackpad_init_start() and then
+// navigator_trackpad_init_step() once per task call, which does at most one
+// bus transfer and returns true while the init is still running.
 void navigator_trackpad_device_init(void);
+void navigator_trackpad_init_start(void);
+bool navigator_trackpad_init_step(void);
+bool navigator_trackpad_init_in_progress(void);
+
+// Fault recovery. The task calls navigator_trackpad_fault_retry() when a
+// report read fails: the first failure of an episode returns true and the task
+// retries the read at once. While the sensor is out of service the task calls
+// navigator_trackpad_recovery_task() every cycle, which re-syncs the bus and
+// then falls back to full re-inits on an exponential backoff.
+// navigator_trackpad_fault_clear() ends an episode after a good read.
+bool navigator_trackpad_fault_retry(void);
+void navigator_trackpad_fault_clear(void);
+void navigator_trackpad_recovery_task(void);
+
+// Bus error telemetry, counted since boot (or the last clear).
+typedef struct {
+    uint32_t nacks;          // transfers failed with I2C_STATUS_ERROR (NACK, arbitration loss)
+    uint32_t timeouts;       // transfers failed with I2C_STATUS_TIMEOUT
+    uint32_t cksum_failures; // memory reads with CGEN6_CKSUM_FAILED
+    uint32_t len_mismatches; // memory reads with CGEN6_LEN_MISMATCH
+    uint32_t retries;        // immediate report-read retries
+    uint32_t resyncs;        // bus re-syncs (ping + config check)
+    uint32_t recoveries;     // times the sensor came back into service after a fault
+} navigator_trackpad_error_stats_t;
+
+const navigator_trackpad_error_stats_t *navigator_trackpad_get_error_stats(void);
+void                                    navigator_trackpad_clear_error_stats(void);
+
+#ifdef NAVIGATOR_TRACKPAD_DR_PIN
+// True while the sensor's data-ready line is asserted.
+bool navigator_trackpad_data_ready(void);
+
+// Liveness probe for data-ready mode. An idle pad never asserts DR, so without
+// it an unplug and replug would go unnoticed and the sensor would be left at
+// its power-on configuration. navigator_trackpad_probe_start() issues a read
+// of FEED_CONFIG4; once the bus is READY, navigator_trackpad_probe_take()
+// consumes the result if it is the probe's and returns true. A failed read, or
+// a value that no longer matches the shadow (or, with the shadow cold, a
+// sensor out of PTP mode), takes the sensor out of service so the recovery
+// path re-syncs it.
+bool navigator_trackpad_probe_start(void);
+bool navigator_trackpad_probe_take(void);
+#endif
 
 // CPI management
 uint16_t navigator_trackpad_get_cpi(void);
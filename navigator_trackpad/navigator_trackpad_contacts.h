@@ -4,7 +4,9 @@
 // Pure, host-testable contact reconciliation for the Navigator trackpad.
 //
 // The Cirque Gen6 sensor and our HID descriptor each track only two
-// simultaneous contacts. The host (libinput / Windows PTP) tracks contacts by
+// simultaneous contacts (NT_MAX_CONTACTS). The reconciler itself handles up to
+// eight, for a larger part with a wider report; the pipeline and report built
+// here stay at two. The host (libinput / Windows PTP) tracks contacts by
 // contact-id and only considers one lifted when it is explicitly reported with
 // tip=0. The job here is to reconcile the contacts the host currently believes
 // are down against the contacts the sensor reports this frame, and produce the
@@ -20,6 +22,12 @@
 #    define NT_MAX_CONTACTS 2
 #endif
 
+// host_ids are kept in a byte-wide bitmap and must fit the HID contact-id.
+_Static_assert(NT_MAX_CONTACTS >= 1 && NT_MAX_CONTACTS <= 8, "NT_MAX_CONTACTS must be 1..8");
+
+// Sensor ids are 6 bits; reconciliation indexes contacts by them.
+#define NT_SENSOR_IDS 64
+
 // A contact as read from the sensor this frame, already scaled and rotated.
 typedef struct {
     uint8_t  id;    // sensor's stable per-finger id (Cirque: 0..63)
@@ -39,10 +47,13 @@ typedef struct {
     bool     conf;
 } nt_host_contact_t;
 
-// The set of contacts the host believes are down. Persisted across frames.
+// The set of contacts the host believes are down. Persisted across frames;
+// all-zero is the empty set.
 typedef struct {
     nt_host_contact_t items[NT_MAX_CONTACTS];
     uint8_t           count;
+    uint8_t           host_used;            // bitmap of the host_ids in items
+    uint8_t           slot[NT_SENSOR_IDS];  // sensor_id -> index in items + 1, 0 = not down
 } nt_contact_state_t;
 
 // One emitted finger in the outgoing HID report.
@@ -63,10 +74,10 @@ typedef struct {
 // sensor contacts reported down this frame (cur, cur_n), producing the fingers
 // to emit (out).
 //
-// Conservative 2-slot policy. The sensor and transport only track two contacts,
-// so a third finger can never be faithfully represented — putting more than two
-// fingers down is degraded input, and the only hard requirement is that we
-// never strand a contact on the host:
+// Conservative N-slot policy. The sensor and transport only track
+// NT_MAX_CONTACTS contacts, so one finger more can never be faithfully
+// represented — that is degraded input, and the only hard requirement is that
+// we never strand a contact on the host:
 //
 //   1. Every contact the host believes down that the sensor no longer reports
 //      is released this frame with tip=0. A contact is NEVER dropped from the
@@ -74,82 +85,97 @@ typedef struct {
 //      left thinking a finger is still down (the "stuck finger" bug).
 //   2. Continuing contacts keep their stable host_id and take updated position.
 //   3. Brand-new contacts are picked up only as free slots allow. When a swap
-//      fills both slots with a release plus a continuing contact, the new finger
+//      fills every slot with releases plus continuing contacts, the new finger
 //      simply waits for a later frame rather than evicting a live contact — this
 //      keeps reported contacts calm instead of churning every frame.
 //
 // host_ids are assigned by us from [0, NT_MAX_CONTACTS) and kept stable for a
 // contact's lifetime, so they always fit the 3-bit HID contact-id field and two
-// live contacts never collide (the raw 6-bit sensor id is never forwarded).
+// live contacts never collide (the raw 6-bit sensor id is never forwarded). A
+// host_id released this frame is not reused until the next, so one report
+// never carries the same contact-id twice.
+//
+// Linear in the number of contacts: sensor ids are matched through st->slot
+// and free host_ids come from the st->host_used bitmap. A sensor id repeated
+// within one frame is taken once.
 static inline void nt_reconcile_contacts(nt_contact_state_t *st,
                                          const nt_sensor_contact_t *cur, uint8_t cur_n,
                                          nt_emit_list_t *out) {
     out->count = 0;
     if (cur_n > NT_MAX_CONTACTS) cur_n = NT_MAX_CONTACTS;
 
-    bool               cur_used[NT_MAX_CONTACTS] = {0};
-    nt_contact_state_t next                      = {0};
+    // Sort this frame's contacts into continuing ones (match, by tracked slot)
+    // and new ones (fresh, in sensor order).
+    int8_t   match[NT_MAX_CONTACTS];
+    uint8_t  fresh[NT_MAX_CONTACTS];
+    uint8_t  fresh_n = 0;
+    uint64_t claimed = 0;
+    for (uint8_t i = 0; i < st->count; i++) match[i] = -1;
+    for (uint8_t j = 0; j < cur_n; j++) {
+        uint8_t  id  = cur[j].id & (NT_SENSOR_IDS - 1);
+        uint64_t bit = (uint64_t)1 << id;
+        if (claimed & bit) continue;
+        claimed |= bit;
+        if (st->slot[id]) {
+            match[st->slot[id] - 1] = j;
+        } else {
+            fresh[fresh_n++] = j;
+        }
+    }
 
     // 1+2. Walk the host-believed-down set: continue contacts the sensor still
-    //      reports, release (tip=0) the ones it no longer does.
+    //      reports, release (tip=0) the ones it no longer does. Kept contacts
+    //      are compacted in place.
+    uint8_t kept     = 0;
+    uint8_t released = 0;
     for (uint8_t i = 0; i < st->count; i++) {
-        int match = -1;
-        for (uint8_t j = 0; j < cur_n; j++) {
-            if (!cur_used[j] && cur[j].id == st->items[i].sensor_id) { match = j; break; }
-        }
+        nt_host_contact_t  c = st->items[i];
         nt_emit_contact_t *e = &out->items[out->count++];
-        e->host_id = st->items[i].host_id;
-        if (match >= 0) {
-            cur_used[match] = true;
-            e->x    = cur[match].x;
-            e->y    = cur[match].y;
-            e->conf = cur[match].conf;
+        e->host_id = c.host_id;
+        if (match[i] >= 0) {
+            const nt_sensor_contact_t *m = &cur[match[i]];
+            e->x    = m->x;
+            e->y    = m->y;
+            e->conf = m->conf;
             e->tip  = true;
             // Keep the contact, with refreshed position, for next frame.
-            nt_host_contact_t *k = &next.items[next.count++];
-            k->sensor_id = st->items[i].sensor_id;
-            k->host_id   = st->items[i].host_id;
-            k->x         = cur[match].x;
-            k->y         = cur[match].y;
-            k->conf      = cur[match].conf;
+            c.x                   = m->x;
+            c.y                   = m->y;
+            c.conf                = m->conf;
+            st->items[kept++]     = c;
+            st->slot[c.sensor_id] = kept;
         } else {
             // Vanished — emit a clean lift at its last known position and drop.
-            e->x    = st->items[i].x;
-            e->y    = st->items[i].y;
-            e->conf = st->items[i].conf;
+            e->x    = c.x;
+            e->y    = c.y;
+            e->conf = c.conf;
             e->tip  = false;
+            st->slot[c.sensor_id] = 0;
+            st->host_used &= ~(1u << c.host_id);
+            released |= 1u << c.host_id;
         }
     }
 
-    // 3. Pick up brand-new contacts into any remaining slots.
-    for (uint8_t j = 0; j < cur_n && out->count < NT_MAX_CONTACTS; j++) {
-        if (cur_used[j]) continue;
-
-        // Lowest host_id in [0, NT_MAX_CONTACTS) not held by a kept contact.
-        uint8_t host_id = 0;
-        for (uint8_t h = 0; h < NT_MAX_CONTACTS; h++) {
-            bool taken = false;
-            for (uint8_t k = 0; k < next.count; k++) {
-                if (next.items[k].host_id == host_id) { taken = true; break; }
-            }
-            if (!taken) break;
-            host_id++;
-        }
+    // 3. Pick up brand-new contacts into any remaining slots, each on the
+    //    lowest host_id neither held nor released this frame. One always
+    //    exists: every emitted finger holds a distinct id and fewer than
+    //    NT_MAX_CONTACTS have been emitted.
+    for (uint8_t f = 0; f < fresh_n && out->count < NT_MAX_CONTACTS; f++) {
+        const nt_sensor_contact_t *n       = &cur[fresh[f]];
+        uint8_t                    host_id = (uint8_t)__builtin_ctz(~(unsigned)(st->host_used | released));
+        uint8_t                    id      = n->id & (NT_SENSOR_IDS - 1);
 
-        nt_host_contact_t *k = &next.items[next.count++];
-        k->sensor_id = cur[j].id;
-        k->host_id   = host_id;
-        k->x         = cur[j].x;
-        k->y         = cur[j].y;
-        k->conf      = cur[j].conf;
+        st->items[kept++] = (nt_host_contact_t){.sensor_id = id, .host_id = host_id, .x = n->x, .y = n->y, .conf = n->conf};
+        st->slot[id]      = kept;
+        st->host_used |= 1u << host_id;
 
         nt_emit_contact_t *e = &out->items[out->count++];
         e->host_id = host_id;
-        e->x       = cur[j].x;
-        e->y       = cur[j].y;
+        e->x       = n->x;
+        e->y       = n->y;
         e->tip     = true;
-        e->conf    = cur[j].conf;
+        e->conf    = n->conf;
     }
 
-    *st = next;
+    st->count = kept;
 }
@@ -96,3 +96,267 @@ static inline void nt_euro_point_reset(nt_euro_point_t *p) {
     p->x = (nt_euro_axis_t){0};
     p->y = (nt_euro_axis_t){0};
 }
+
+// --- Filter timestep ----------------------------------------------------------
+// dt for the filter, clocked from the sensor's own frame timestamps. The MCU
+// timer only counts whole milliseconds and samples the frame whenever the
+// poll happens to land, so at 8 ms frames a timer-derived dt jitters by
+// +/-1 ms or more, and that jitter goes straight into the derivative and the
+// smoothing factor. scan_time (100 us units, wrapping at 16 bits) is stamped
+// by the sensor when it samples, so consecutive deltas are exact. If it stalls
+// (no advance) or jumps implausibly (sensor reset, idle gap), fall back to
+// the MCU timer for that frame. Either way dt is clamped to
+// [NT_DT_MIN, NT_DT_MAX] so a first frame or gap can't produce a degenerate
+// derivative / alpha.
+#define NT_DT_MIN 0.001f
+#define NT_DT_MAX 0.050f
+#define NT_DT_MIN_TICKS 10   // NT_DT_MIN in scan_time units (100 us)
+#define NT_DT_MAX_TICKS 500  // NT_DT_MAX in scan_time units
+
+typedef struct {
+    uint16_t scan;  // scan_time of the previous frame
+    uint32_t ms;    // MCU time of the previous frame
+} nt_frame_clock_t;
+
+// dt in scan_time units (100 us), clamped.
+static inline uint16_t nt_frame_ticks(nt_frame_clock_t *c, uint16_t scan_time, uint32_t now_ms) {
+    uint16_t dscan = (uint16_t)(scan_time - c->scan);  // wraps cleanly
+    uint32_t ticks;
+    if (dscan > 0 && dscan <= NT_DT_MAX_TICKS) {
+        ticks = dscan;
+    } else {
+        ticks = (now_ms - c->ms) * 10;
+    }
+    c->scan = scan_time;
+    c->ms   = now_ms;
+    if (ticks < NT_DT_MIN_TICKS) ticks = NT_DT_MIN_TICKS;
+    if (ticks > NT_DT_MAX_TICKS) ticks = NT_DT_MAX_TICKS;
+    return (uint16_t)ticks;
+}
+
+static inline float nt_frame_dt(nt_frame_clock_t *c, uint16_t scan_time, uint32_t now_ms) {
+    return (float)nt_frame_ticks(c, scan_time, now_ms) / 10000.0f;
+}
+
+// --- Fixed-point One Euro -----------------------------------------------------
+// The same filter with integer arithmetic only, for targets without an FPU
+// (soft-float costs several hundred cycles per operation there). Formats are
+// chosen so every product fits in 32 bits, with no 64-bit multiply:
+//   position     Q7 logical units (1/128 unit)
+//   speed        whole logical units per second
+//   alpha        Q12 (1/4096)
+//   cutoff       Q8 Hz; beta Q20 Hz per unit/s
+//   dt           Q16 seconds, plus 1/dt in Q4 Hz
+// The smoothing factor depends only on u = cutoff * dt, so it comes from a
+// table over u (linearly interpolated) instead of a division per call. The
+// single remaining division, 1/dt, is done once per frame and shared by every
+// axis of every contact. Stays within one logical unit of the float filter
+// (tests/filter_test.c).
+
+// alpha(u) = 2*pi*u / (1 + 2*pi*u), the float nt_euro_alpha() rearranged.
+#define NT_EURO_ALPHA_Q12(u) ((uint16_t)(4096.0 * (6.283185307179586 * (u)) / (1.0 + 6.283185307179586 * (u)) + 0.5))
+#define NT_EURO_FINE(i) NT_EURO_ALPHA_Q12((i) / 128.0)       // u in [0, 1], step 1/128
+#define NT_EURO_COARSE(i) NT_EURO_ALPHA_Q12(1.0 + (i) / 8.0)  // u in [1, 8], step 1/8
+#define NT_EURO_R4(M, b) M(b), M(b + 1), M(b + 2), M(b + 3)
+#define NT_EURO_R8(M, b) NT_EURO_R4(M, b), NT_EURO_R4(M, b + 4)
+#define NT_EURO_R16(M, b) NT_EURO_R8(M, b), NT_EURO_R8(M, b + 8)
+#define NT_EURO_R64(M, b) NT_EURO_R16(M, b), NT_EURO_R16(M, b + 16), NT_EURO_R16(M, b + 32), NT_EURO_R16(M, b + 48)
+
+static const uint16_t nt_euro_alpha_fine[129]  = {NT_EURO_R64(NT_EURO_FINE, 0), NT_EURO_R64(NT_EURO_FINE, 64), NT_EURO_FINE(128)};
+static const uint16_t nt_euro_alpha_coarse[57] = {NT_EURO_R16(NT_EURO_COARSE, 0), NT_EURO_R16(NT_EURO_COARSE, 16), NT_EURO_R16(NT_EURO_COARSE, 32), NT_EURO_R8(NT_EURO_COARSE, 48), NT_EURO_COARSE(56)};
+
+// Convert the float tuning constants at compile time.
+#define NT_EURO_HZ_Q8(hz) ((uint32_t)((hz) * 256.0f + 0.5f))
+#define NT_EURO_BETA_Q20(beta) ((uint32_t)((beta) * 1048576.0f + 0.5f))
+
+// Smoothing factor (Q12) for u = cutoff * dt in Q16.
+static inline uint16_t nt_euro_alpha_fixed(uint32_t u_q16) {
+    if (u_q16 < 65536) {
+        uint32_t i = u_q16 >> 9, frac = u_q16 & 0x1FF;
+        return (uint16_t)(nt_euro_alpha_fine[i] + (((nt_euro_alpha_fine[i + 1] - nt_euro_alpha_fine[i]) * frac) >> 9));
+    }
+    if (u_q16 >= 8 * 65536) {
+        return nt_euro_alpha_coarse[56];
+    }
+    uint32_t v = u_q16 - 65536, i = v >> 13, frac = v & 0x1FFF;
+    return (uint16_t)(nt_euro_alpha_coarse[i] + (((nt_euro_alpha_coarse[i + 1] - nt_euro_alpha_coarse[i]) * frac) >> 13));
+}
+
+typedef struct {
+    int32_t hatx;
+    bool    init;
+} nt_lowpass_fixed_t;
+
+static inline int32_t nt_lowpass_fixed(nt_lowpass_fixed_t *lp, int32_t x, uint16_t alpha_q12) {
+    if (!lp->init) {
+        lp->hatx = x;
+        lp->init = true;
+        return x;
+    }
+    lp->hatx += ((int32_t)alpha_q12 * (x - lp->hatx) + 2048) >> 12;
+    return lp->hatx;
+}
+
+typedef struct {
+    nt_lowpass_fixed_t x;      // position low-pass, Q7
+    nt_lowpass_fixed_t dx;     // speed low-pass, units/s
+    int32_t            xprev;  // previous raw input, Q7
+    bool               init;
+} nt_euro_axis_fixed_t;
+
+typedef struct {
+    nt_euro_axis_fixed_t x;
+    nt_euro_axis_fixed_t y;
+} nt_euro_point_fixed_t;
+
+// Per-frame timestep, shared by all axes and contacts.
+typedef struct {
+    uint16_t dt_q16;     // dt, Q16 seconds
+    uint16_t inv_dt_q4;  // 1/dt, Q4 Hz
+    uint16_t alpha_d;    // speed low-pass alpha for dcutoff, Q12
+} nt_euro_fixed_dt_t;
+
+static inline void nt_euro_fixed_dt(nt_euro_fixed_dt_t *f, uint16_t dt_ticks, uint32_t dcutoff_q8) {
+    f->dt_q16    = (uint16_t)(((uint32_t)dt_ticks * 53687u) >> 13);  // ticks * 65536 / 10000
+    f->inv_dt_q4 = (uint16_t)(160000u / dt_ticks);
+    f->alpha_d   = nt_euro_alpha_fixed((dcutoff_q8 * f->dt_q16) >> 8);
+}
+
+// Filter one axis sample (whole logical units); returns Q7.
+static inline int32_t nt_euro_axis_filter_fixed(nt_euro_axis_fixed_t *f, int32_t x, const nt_euro_fixed_dt_t *dt,
+                                                uint32_t mincutoff_q8, uint32_t beta_q20) {
+    int32_t xq = x << 7;
+    int32_t dx = 0;
+    if (!f->init) {
+        f->init = true;
+    } else {
+        int32_t delta = xq - f->xprev;
+        if (delta > 65535) delta = 65535;
+        if (delta < -65535) delta = -65535;
+        dx = (delta * dt->inv_dt_q4) >> 11;
+        if (dx > 131071) dx = 131071;
+        if (dx < -131071) dx = -131071;
+    }
+    f->xprev = xq;
+
+    int32_t  edx    = nt_lowpass_fixed(&f->dx, dx, dt->alpha_d);
+    uint32_t cutoff = mincutoff_q8 + ((beta_q20 * (uint32_t)(edx < 0 ? -edx : edx)) >> 12);
+    return nt_lowpass_fixed(&f->x, xq, nt_euro_alpha_fixed((cutoff * dt->dt_q16) >> 8));
+}
+
+// Filter an (x, y) point in place, rounding back to whole units.
+static inline void nt_euro_point_filter_fixed(nt_euro_point_fixed_t *p, int32_t *x, int32_t *y,
+                                              const nt_euro_fixed_dt_t *dt, uint32_t mincutoff_q8,
+                                              uint32_t beta_q20) {
+    *x = (nt_euro_axis_filter_fixed(&p->x, *x, dt, mincutoff_q8, beta_q20) + 64) >> 7;
+    *y = (nt_euro_axis_filter_fixed(&p->y, *y, dt, mincutoff_q8, beta_q20) + 64) >> 7;
+}
+
+static inline void nt_euro_point_reset_fixed(nt_euro_point_fixed_t *p) {
+    p->x = (nt_euro_axis_fixed_t){0};
+    p->y = (nt_euro_axis_fixed_t){0};
+}
+
+// --- Noise-floor estimate -------------------------------------------------------
+// MINCUTOFF is a trade between still-finger jitter and low-speed lag, and the
+// right value depends on the sensor's noise floor, which differs from unit to
+// unit and with USB power and grounding. This estimates the jitter variance of
+// each axis while a contact is stationary and scales mincutoff so the residual
+// jitter stays where the defaults put it on the reference trace: quiet units
+// get a higher cutoff (less lag), noisy units a lower one (less wobble).
+//
+// The first-order low-pass passes a fraction ~ cutoff of white noise variance,
+// so holding the output constant means cutoff ~ 1 / variance:
+//   mincutoff = nominal * ref_var / var, clamped to [lo, hi].
+// On a very noisy pad the jitter also lifts the speed term (beta), so the
+// gain there is smaller than on a quiet one (tests/filter_test.c).
+//
+// Variance is taken from frame-to-frame differences (var(dx) = 2 sigma^2 for
+// white noise), which a slowly drifting finger barely moves, and only once
+// the contact has stayed within NT_NOISE_STILL units of its running mean for
+// NT_NOISE_SETTLE frames. The estimate is per pad, not per touch (noise is a
+// property of the unit), and starts at the reference so the cutoff starts at
+// its nominal value. Integer only; the per-contact state is a few words.
+
+#define NT_NOISE_STILL 32   // units from the running mean still counted as stationary
+#define NT_NOISE_SETTLE 8   // stationary frames before sampling starts
+#define NT_NOISE_SHIFT 8    // EWMA time constant, 2^n stationary frames (~2 s)
+#define NT_NOISE_DMAX 64    // larger frame-to-frame steps are clipped
+
+#define NT_NOISE_VAR_Q4(var) ((int32_t)((var) * 16.0f + 0.5f))
+
+typedef struct {
+    int32_t  dvar_q12[2];      // per-axis variance of frame-to-frame differences, Q12 units^2
+    uint16_t mincutoff_q8[2];  // per-axis mincutoff derived from it, Q8 Hz
+} nt_noise_t;
+
+// Per-contact state.
+typedef struct {
+    int32_t last[2];  // previous sample, units
+    int32_t mean[2];  // running mean, Q4 units
+    uint8_t still;    // consecutive stationary frames (saturating)
+    bool    init;
+} nt_noise_contact_t;
+
+typedef struct {
+    uint16_t nominal_q8;  // mincutoff at the reference noise, Q8 Hz
+    int32_t  ref_var_q4;  // reference noise variance (sigma^2), Q4 units^2
+    uint16_t lo_q8, hi_q8;
+} nt_noise_cfg_t;
+
+// Initial state: the reference noise on both axes, so mincutoff starts nominal.
+#define NT_NOISE_INIT(nominal_q8, ref_var_q4) \
+    { {(ref_var_q4) << 9, (ref_var_q4) << 9}, {(nominal_q8), (nominal_q8)} }
+
+// Noise variance (sigma^2) of an axis, Q4 units^2.
+static inline int32_t nt_noise_var_q4(const nt_noise_t *n, uint8_t axis) {
+    return n->dvar_q12[axis] >> 9;
+}
+
+// Feed one sample of a down contact.
+static inline void nt_noise_update(nt_noise_t *n, nt_noise_contact_t *c, int32_t x, int32_t y,
+                                   const nt_noise_cfg_t *cfg) {
+    int32_t p[2] = {x, y};
+    if (!c->init) {
+        for (uint8_t a = 0; a < 2; a++) {
+            c->last[a] = p[a];
+            c->mean[a] = p[a] << 4;
+        }
+        c->still = 0;
+        c->init  = true;
+        return;
+    }
+    bool    still = true;
+    int32_t d[2];
+    for (uint8_t a = 0; a < 2; a++) {
+        d[a] = p[a] - c->last[a];
+        c->last[a] = p[a];
+        c->mean[a] += ((p[a] << 4) - c->mean[a]) >> 3;
+        int32_t off = (p[a] << 4) - c->mean[a];
+        if (off > NT_NOISE_STILL * 16 || off < -NT_NOISE_STILL * 16) still = false;
+    }
+    if (!still) {
+        c->still = 0;
+        return;
+    }
+    if (c->still < NT_NOISE_SETTLE) {
+        c->still++;
+        return;
+    }
+    for (uint8_t a = 0; a < 2; a++) {
+        int32_t da = d[a];
+        if (da > NT_NOISE_DMAX) da = NT_NOISE_DMAX;
+        if (da < -NT_NOISE_DMAX) da = -NT_NOISE_DMAX;
+        n->dvar_q12[a] += ((da * da << 12) - n->dvar_q12[a]) >> NT_NOISE_SHIFT;
+
+        int32_t v  = (n->dvar_q12[a] >> 8) > 0 ? n->dvar_q12[a] >> 8 : 1;  // Q4
+        int32_t fc = (int32_t)cfg->nominal_q8 * 2 * cfg->ref_var_q4 / v;
+        if (fc < cfg->lo_q8) fc = cfg->lo_q8;
+        if (fc > cfg->hi_q8) fc = cfg->hi_q8;
+        n->mincutoff_q8[a] = (uint16_t)fc;
+    }
+}
+
+static inline void nt_noise_contact_reset(nt_noise_contact_t *c) {
+    *c = (nt_noise_contact_t){0};
+}
@@ -15,50 +15,215 @@
 // bilinear correction grid that minimizes per-stroke curvature, and bounding
 // every node to +/-40 logical units (~1 mm) so sparsely-sampled edge cells can
 // never produce an unphysical warp. Values are in logical units
-// (0..TRACKPAD_LOGICAL_MAX). Index order is [x_node][y_node].
+// (0..TRACKPAD_LOGICAL_MAX). Index order is [x_node][y_node]; each row is
+// also a macro so the per-cell slopes below can be derived from it at compile
+// time.
 //
 // NOTE: calibrated against one physical unit. If the distortion proves to vary
-// between sensors, this table is unit-specific and must not ship as-is.
+// between sensors, this table is unit-specific and must not ship as-is. A
+// per-unit table (9x9, 17x17, ...) fitted with tools/nt_lut_fit can be stored
+// in EEPROM and is loaded once at init (NAVIGATOR_TRACKPAD_LUT_EEPROM); this
+// compiled table is the fallback when none is stored.
 
 #pragma once
 
 #include <math.h>
+#include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 #include "navigator_trackpad_common.h"  // TRACKPAD_LOGICAL_MAX
+#include "navigator_trackpad_lut_blob.h"
 
 #ifndef NAVIGATOR_TRACKPAD_LUT_CORRECTION
 #    define NAVIGATOR_TRACKPAD_LUT_CORRECTION TRUE
 #endif
+// Load a per-unit table from EEPROM at init. The blob (see
+// navigator_trackpad_lut_blob.h) lives at NAVIGATOR_TRACKPAD_LUT_EEPROM_ADDR,
+// which has no default: the space just past QMK's eeconfig is where the
+// dynamic keymap (VIA/Oryx) starts, so pick a range nothing else uses and
+// reserve NT_LUT_BLOB_SIZE(NAVIGATOR_TRACKPAD_LUT_EEPROM_MAX_GRID) bytes
+// there. Its cells are built into RAM once: 12 bytes per cell, 768 B for 9x9
+// and 3 KB for 17x17, sized by NAVIGATOR_TRACKPAD_LUT_EEPROM_MAX_GRID. Larger
+// blobs are ignored.
+#ifndef NAVIGATOR_TRACKPAD_LUT_EEPROM
+#    define NAVIGATOR_TRACKPAD_LUT_EEPROM FALSE
+#endif
+#if NAVIGATOR_TRACKPAD_LUT_EEPROM == TRUE && !defined(NAVIGATOR_TRACKPAD_LUT_EEPROM_ADDR)
+#    error "NAVIGATOR_TRACKPAD_LUT_EEPROM needs NAVIGATOR_TRACKPAD_LUT_EEPROM_ADDR, clear of eeconfig and the dynamic keymap"
+#endif
+#ifndef NAVIGATOR_TRACKPAD_LUT_EEPROM_MAX_GRID
+#    define NAVIGATOR_TRACKPAD_LUT_EEPROM_MAX_GRID 17
+#endif
 
 #define NT_LUT_G 9
+// Logical units per grid cell. The integer path splits a coordinate into cell
+// and Q8 fraction with a shift, so this must stay 256.
+#define NT_LUT_CELL_UNITS (TRACKPAD_LOGICAL_MAX / (NT_LUT_G - 1))
+_Static_assert(NT_LUT_CELL_UNITS == 256, "integer LUT path assumes 256-unit cells");
+
+#define NT_LUT_EX_0    1,  -10,  -25,  -40,  -40,  -32,  -13,    9,   20
+#define NT_LUT_EX_1    0,   -8,  -18,  -26,  -37,  -40,  -38,   11,   20
+#define NT_LUT_EX_2    1,   -3,  -10,  -17,  -31,  -40,  -38,   -9,   -3
+#define NT_LUT_EX_3   12,    7,    0,   -9,  -15,  -15,  -16,  -15,  -36
+#define NT_LUT_EX_4   17,   28,   15,    5,   10,   14,    7,   -8,  -40
+#define NT_LUT_EX_5   -2,   15,   32,   31,   31,   27,   19,   11,    1
+#define NT_LUT_EX_6  -29,    0,   40,   40,   30,   18,   20,   16,   10
+#define NT_LUT_EX_7  -32,    0,   40,   38,   19,    4,   15,   11,    7
+#define NT_LUT_EX_8  -12,    7,   23,   12,  -18,  -40,  -16,   -1,    5
 
 static const int8_t NT_LUT_EX[NT_LUT_G][NT_LUT_G] = {
-    {   1,  -10,  -25,  -40,  -40,  -32,  -13,    9,   20},
-    {   0,   -8,  -18,  -26,  -37,  -40,  -38,   11,   20},
-    {   1,   -3,  -10,  -17,  -31,  -40,  -38,   -9,   -3},
-    {  12,    7,    0,   -9,  -15,  -15,  -16,  -15,  -36},
-    {  17,   28,   15,    5,   10,   14,    7,   -8,  -40},
-    {  -2,   15,   32,   31,   31,   27,   19,   11,    1},
-    { -29,    0,   40,   40,   30,   18,   20,   16,   10},
-    { -32,    0,   40,   38,   19,    4,   15,   11,    7},
-    { -12,    7,   23,   12,  -18,  -40,  -16,   -1,    5},
+    {NT_LUT_EX_0},
+    {NT_LUT_EX_1},
+    {NT_LUT_EX_2},
+    {NT_LUT_EX_3},
+    {NT_LUT_EX_4},
+    {NT_LUT_EX_5},
+    {NT_LUT_EX_6},
+    {NT_LUT_EX_7},
+    {NT_LUT_EX_8},
 };
 
+#define NT_LUT_EY_0    0,   16,   36,   40,   27,   -2,  -40,  -20,    5
+#define NT_LUT_EY_1   -6,   -4,   -4,   -1,    8,    5,   -1,   20,   10
+#define NT_LUT_EY_2  -17,  -25,  -30,  -31,   -2,   25,   31,   31,    2
+#define NT_LUT_EY_3  -32,  -39,  -40,  -40,   -8,   40,   40,   36,    1
+#define NT_LUT_EY_4  -27,  -39,  -40,  -40,  -13,   39,   40,   40,   25
+#define NT_LUT_EY_5  -17,  -34,  -37,  -40,  -15,   36,   40,   40,   33
+#define NT_LUT_EY_6   -4,  -19,  -29,  -40,  -17,   34,   40,   40,   24
+#define NT_LUT_EY_7   -1,   -9,  -10,  -34,  -20,   19,    6,   11,    8
+#define NT_LUT_EY_8    3,    3,   -4,  -31,  -26,   40,  -29,  -26,   -8
+
 static const int8_t NT_LUT_EY[NT_LUT_G][NT_LUT_G] = {
-    {   0,   16,   36,   40,   27,   -2,  -40,  -20,    5},
-    {  -6,   -4,   -4,   -1,    8,    5,   -1,   20,   10},
-    { -17,  -25,  -30,  -31,   -2,   25,   31,   31,    2},
-    { -32,  -39,  -40,  -40,   -8,   40,   40,   36,    1},
-    { -27,  -39,  -40,  -40,  -13,   39,   40,   40,   25},
-    { -17,  -34,  -37,  -40,  -15,   36,   40,   40,   33},
-    {  -4,  -19,  -29,  -40,  -17,   34,   40,   40,   24},
-    {  -1,   -9,  -10,  -34,  -20,   19,    6,   11,    8},
-    {   3,    3,   -4,  -31,  -26,   40,  -29,  -26,   -8},
+    {NT_LUT_EY_0},
+    {NT_LUT_EY_1},
+    {NT_LUT_EY_2},
+    {NT_LUT_EY_3},
+    {NT_LUT_EY_4},
+    {NT_LUT_EY_5},
+    {NT_LUT_EY_6},
+    {NT_LUT_EY_7},
+    {NT_LUT_EY_8},
 };
 
+// Per-cell form of the field for the integer path. Over cell (i, j), with
+// fractions tx, ty in [0, 1]:
+//   E = e + dx*tx + dy*ty + dxy*tx*ty
+// where e is node [i][j], dx/dy the slopes along x/y, and dxy the twist term.
+// Node values are bounded to +/-40, so slopes fit int8 and the twist int16.
+typedef struct {
+    int16_t dxy;
+    int8_t  e, dx, dy;
+} nt_lut_cell_t;
+
+// a0/a1: nodes [i][j], [i][j+1]; b0/b1: nodes [i+1][j], [i+1][j+1].
+#define NT_LUT_CELL(a0, a1, b0, b1) {(b1) - (b0) - (a1) + (a0), (a0), (b0) - (a0), (a1) - (a0)}
+#define NT_LUT_CELL_ROW(a0, a1, a2, a3, a4, a5, a6, a7, a8, b0, b1, b2, b3, b4, b5, b6, b7, b8) \
+    {NT_LUT_CELL(a0, a1, b0, b1), NT_LUT_CELL(a1, a2, b1, b2), NT_LUT_CELL(a2, a3, b2, b3),    \
+     NT_LUT_CELL(a3, a4, b3, b4), NT_LUT_CELL(a4, a5, b4, b5), NT_LUT_CELL(a5, a6, b5, b6),    \
+     NT_LUT_CELL(a6, a7, b6, b7), NT_LUT_CELL(a7, a8, b7, b8)}
+#define NT_LUT_CELL_ROW_(...) NT_LUT_CELL_ROW(__VA_ARGS__)
+#define NT_LUT_CELLS(E)                                                                    \
+    {NT_LUT_CELL_ROW_(E##_0, E##_1), NT_LUT_CELL_ROW_(E##_1, E##_2), NT_LUT_CELL_ROW_(E##_2, E##_3), \
+     NT_LUT_CELL_ROW_(E##_3, E##_4), NT_LUT_CELL_ROW_(E##_4, E##_5), NT_LUT_CELL_ROW_(E##_5, E##_6), \
+     NT_LUT_CELL_ROW_(E##_6, E##_7), NT_LUT_CELL_ROW_(E##_7, E##_8)}
+
+static const nt_lut_cell_t NT_LUT_CELLS_X[NT_LUT_G - 1][NT_LUT_G - 1] = NT_LUT_CELLS(NT_LUT_EX);
+static const nt_lut_cell_t NT_LUT_CELLS_Y[NT_LUT_G - 1][NT_LUT_G - 1] = NT_LUT_CELLS(NT_LUT_EY);
+
+// A correction table in cell form: `cells` x `cells` cells of 2^shift logical
+// units each, cell (i, j) at [i * cells + j]. Lookups index it directly, so a
+// table loaded at init costs the same per contact as the compiled one.
+typedef struct {
+    uint8_t              shift;
+    uint8_t              cells;
+    const nt_lut_cell_t *x;
+    const nt_lut_cell_t *y;
+} nt_lut_t;
+
+static const nt_lut_t NT_LUT_COMPILED = {8, NT_LUT_G - 1, &NT_LUT_CELLS_X[0][0], &NT_LUT_CELLS_Y[0][0]};
+
+// Cells (both axes) for a grid of g nodes per axis.
+#define NT_LUT_CELL_COUNT(g) (2 * ((g) - 1) * ((g) - 1))
+
+// Reads `len` bytes at `offset` into the stored blob.
+typedef void (*nt_lut_read_t)(void *dst, uint16_t offset, uint16_t len);
+
+// Load a stored blob into `lut`, building its cells into `cells` (room for
+// `max_cells`). Streams the nodes a row at a time, so the blob is never held
+// in RAM whole: one pass for the checksum and bounds, one to build the cells.
+// Returns false, leaving `lut` untouched, for a missing, corrupt or oversized
+// blob.
+static inline bool nt_lut_load(nt_lut_t *lut, nt_lut_cell_t *cells, size_t max_cells, nt_lut_read_t read) {
+    uint8_t hdr[NT_LUT_BLOB_HEADER];
+    read(hdr, 0, sizeof(hdr));
+    if (!nt_lut_blob_header_ok(hdr) || (size_t)NT_LUT_CELL_COUNT(hdr[5]) > max_cells) {
+        return false;
+    }
+    uint8_t  g = hdr[5], n = g - 1;
+    int8_t   r0[NT_LUT_BLOB_MAX_GRID], r1[NT_LUT_BLOB_MAX_GRID];
+    uint16_t a = 0, b = 0;
+    nt_lut_blob_fletcher(&a, &b, &hdr[5], 1);
+    for (uint16_t r = 0; r < 2 * g; r++) {
+        read(r0, NT_LUT_BLOB_HEADER + r * g, g);
+        nt_lut_blob_fletcher(&a, &b, (const uint8_t *)r0, g);
+        if (!nt_lut_blob_nodes_ok(r0, g)) return false;
+    }
+    if ((uint16_t)((b << 8) | a) != (uint16_t)(hdr[6] | (hdr[7] << 8))) {
+        return false;
+    }
+
+    for (uint8_t axis = 0; axis < 2; axis++) {
+        uint16_t       base = NT_LUT_BLOB_HEADER + axis * g * g;
+        nt_lut_cell_t *out  = &cells[axis * n * n];
+        read(r0, base, g);
+        for (uint8_t i = 0; i < n; i++) {
+            read(r1, base + (i + 1) * g, g);
+            for (uint8_t j = 0; j < n; j++) {
+                out[i * n + j] = (nt_lut_cell_t)NT_LUT_CELL(r0[j], r0[j + 1], r1[j], r1[j + 1]);
+            }
+            memcpy(r0, r1, g);
+        }
+    }
+    uint8_t shift = 0;
+    while (((uint32_t)n << shift) < TRACKPAD_LOGICAL_MAX) shift++;
+    *lut = (nt_lut_t){shift, n, cells, &cells[n * n]};
+    return true;
+}
+
+// Field value at (tx, ty) in Q8 within a cell, times 65536.
+static inline int32_t nt_lut_cell_eval(const nt_lut_cell_t *c, int32_t tx, int32_t ty) {
+    return ((int32_t)c->e << 16) + (((int32_t)c->dx * tx + (int32_t)c->dy * ty) << 8) + (int32_t)c->dxy * tx * ty;
+}
+
 // Subtract the bilinearly-interpolated distortion field from an absolute
 // logical point (x, y), straightening the reported coordinate in place.
+// Integer only: a shift splits each coordinate into cell and Q8 fraction, and
+// the field is a few multiply-adds on the precomputed cell slopes. Agrees
+// with nt_lut_correct_float() to one unit over the whole pad (tests/lut_test.c).
 static inline void nt_lut_correct(uint16_t *x, uint16_t *y) {
+    int32_t px = *x > TRACKPAD_LOGICAL_MAX ? TRACKPAD_LOGICAL_MAX : *x;
+    int32_t py = *y > TRACKPAD_LOGICAL_MAX ? TRACKPAD_LOGICAL_MAX : *y;
+    int32_t ix = px >> 8, tx = px & 0xFF;
+    int32_t iy = py >> 8, ty = py & 0xFF;
+    // The far edge belongs to the last cell, at fraction 1.
+    if (ix == NT_LUT_G - 1) ix--, tx = 256;
+    if (iy == NT_LUT_G - 1) iy--, ty = 256;
+
+    int32_t ex = nt_lut_cell_eval(&NT_LUT_CELLS_X[ix][iy], tx, ty);
+    int32_t ey = nt_lut_cell_eval(&NT_LUT_CELLS_Y[ix][iy], tx, ty);
+
+    int32_t nx = ((px << 16) - ex + 32768) >> 16;
+    int32_t ny = ((py << 16) - ey + 32768) >> 16;
+    if (nx < 0) nx = 0;
+    if (nx > TRACKPAD_LOGICAL_MAX) nx = TRACKPAD_LOGICAL_MAX;
+    if (ny < 0) ny = 0;
+    if (ny > TRACKPAD_LOGICAL_MAX) ny = TRACKPAD_LOGICAL_MAX;
+    *x = (uint16_t)nx;
+    *y = (uint16_t)ny;
+}
+
+// Float reference for nt_lut_correct(), kept for the host test.
+static inline void nt_lut_correct_float(uint16_t *x, uint16_t *y) {
     const float scale = (float)(NT_LUT_G - 1) / (float)TRACKPAD_LOGICAL_MAX;
     float fx = (float)(*x) * scale;
     float fy = (float)(*y) * scale;
@@ -0,0 +1,91 @@
+// Copyright 2026 ZSA Technology Labs, Inc <contact@zsa.io>
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// Storage format of a per-unit distortion table, shared by the firmware loader
+// (navigator_trackpad_lut.h) and the host fitting tool (tools/nt_lut_fit.c).
+//
+//   offset  size  field
+//   0       4     magic "NTLT"
+//   4       1     version (NT_LUT_BLOB_VERSION)
+//   5       1     grid: nodes per axis, 2^k + 1 (9 or 17, ...)
+//   6       2     Fletcher-16 of the grid byte and both node arrays, LE
+//   8       g*g   EX nodes, int8, [x_node][y_node]
+//   8+g*g   g*g   EY nodes, int8, [x_node][y_node]
+//
+// Node values are logical units, bounded to +/-NT_LUT_BLOB_BOUND. A blank
+// (0xFF) or foreign EEPROM fails the magic or checksum and is ignored.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define NT_LUT_BLOB_MAGIC0 'N'
+#define NT_LUT_BLOB_MAGIC1 'T'
+#define NT_LUT_BLOB_MAGIC2 'L'
+#define NT_LUT_BLOB_MAGIC3 'T'
+#define NT_LUT_BLOB_VERSION 1
+#define NT_LUT_BLOB_HEADER 8
+#define NT_LUT_BLOB_BOUND 40
+#define NT_LUT_BLOB_SIZE(g) (NT_LUT_BLOB_HEADER + 2 * (g) * (g))
+
+// Fletcher-16, continued over `n` more bytes. Start from a = b = 0.
+static inline void nt_lut_blob_fletcher(uint16_t *a, uint16_t *b, const uint8_t *p, size_t n) {
+    while (n--) {
+        *a = (*a + *p++) % 255;
+        *b = (*b + *a) % 255;
+    }
+}
+
+// Checksum of a blob in memory: the grid byte followed by the nodes.
+static inline uint16_t nt_lut_blob_checksum(const uint8_t *blob) {
+    uint16_t a = 0, b = 0;
+    nt_lut_blob_fletcher(&a, &b, &blob[5], 1);
+    nt_lut_blob_fletcher(&a, &b, &blob[NT_LUT_BLOB_HEADER], (size_t)2 * blob[5] * blob[5]);
+    return (uint16_t)((b << 8) | a);
+}
+
+// Grid sizes the loader accepts: 2^k + 1 nodes per axis, k = 1..5.
+#define NT_LUT_BLOB_MAX_GRID 33
+static inline bool nt_lut_blob_grid_ok(uint8_t g) {
+    return g >= 3 && g <= NT_LUT_BLOB_MAX_GRID && (((g - 1) & (g - 2)) == 0);
+}
+
+// Magic, version and grid size of a blob header.
+static inline bool nt_lut_blob_header_ok(const uint8_t *hdr) {
+    return hdr[0] == NT_LUT_BLOB_MAGIC0 && hdr[1] == NT_LUT_BLOB_MAGIC1 && hdr[2] == NT_LUT_BLOB_MAGIC2 &&
+           hdr[3] == NT_LUT_BLOB_MAGIC3 && hdr[4] == NT_LUT_BLOB_VERSION && nt_lut_blob_grid_ok(hdr[5]);
+}
+
+// Every one of `n` nodes within +/-NT_LUT_BLOB_BOUND.
+static inline bool nt_lut_blob_nodes_ok(const int8_t *nodes, size_t n) {
+    while (n--) {
+        if (*nodes > NT_LUT_BLOB_BOUND || *nodes < -NT_LUT_BLOB_BOUND) return false;
+        nodes++;
+    }
+    return true;
+}
+
+// Header, checksum and node bounds of a blob in memory, everything the loader
+// checks; `len` must cover the whole blob.
+static inline bool nt_lut_blob_valid(const uint8_t *blob, size_t len) {
+    if (len < NT_LUT_BLOB_HEADER || !nt_lut_blob_header_ok(blob) || len < NT_LUT_BLOB_SIZE((size_t)blob[5])) {
+        return false;
+    }
+    return nt_lut_blob_checksum(blob) == (uint16_t)(blob[6] | (blob[7] << 8)) &&
+           nt_lut_blob_nodes_ok((const int8_t *)&blob[NT_LUT_BLOB_HEADER], (size_t)2 * blob[5] * blob[5]);
+}
+
+// Fill in the header of a blob whose nodes are already in place.
+static inline void nt_lut_blob_seal(uint8_t *blob, uint8_t g) {
+    blob[0]      = NT_LUT_BLOB_MAGIC0;
+    blob[1]      = NT_LUT_BLOB_MAGIC1;
+    blob[2]      = NT_LUT_BLOB_MAGIC2;
+    blob[3]      = NT_LUT_BLOB_MAGIC3;
+    blob[4]      = NT_LUT_BLOB_VERSION;
+    blob[5]      = g;
+    uint16_t sum = nt_lut_blob_checksum(blob);
+    blob[6]      = sum & 0xFF;
+    blob[7]      = sum >> 8;
+}
@@ -0,0 +1,579 @@
+// Copyright 2026 ZSA Technology Labs, Inc <contact@zsa.io>
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// The Navigator trackpad's frame pipeline, from a decoded sensor frame to the
+// PTP and fallback-mouse reports. See navigator_trackpad_pipeline.h.
+
+#include <math.h>
+#include <string.h>
+#include "navigator_trackpad_pipeline.h"
+#include "navigator_trackpad_accel.h"
+#include "navigator_trackpad_profile.h"
+#include "navigator_trackpad_ptp.h"
+#include "navigator_trackpad_transform.h"
+
+// Normalize the configured angle to [0, 360) so negative or >360 values still
+// hit the integer right-angle fast-paths.
+#define _NAVIGATOR_TRACKPAD_ROT (((NAVIGATOR_TRACKPAD_ROTATION % 360) + 360) % 360)
+
+// Raw sensor point (rx, ry) to corrected, rotated logical point (lvalues px,
+// py) in one integer pass; see navigator_trackpad_transform.h.
+#define NT_TRANSFORM_POINT(lut, rx, ry, px, py)                                                     \
+    nt_transform_point((rx), (ry), NT_TRANSFORM_COS_Q14(_NAVIGATOR_TRACKPAD_ROT),                   \
+                       NT_TRANSFORM_SIN_Q14(_NAVIGATOR_TRACKPAD_ROT),                               \
+                       (lut), &(px), &(py))
+
+// PTP report structure constants
+#define PTP_REPORT_ID           0x01
+#define PTP_REPORT_SIZE         16
+#define PTP_FINGER0_OFFSET      1
+#define PTP_FINGER1_OFFSET      7
+#define PTP_SCAN_TIME_OFFSET    13
+#define PTP_COUNT_BUTTONS_OFFSET 15
+
+// Only the reconciler (navigator_trackpad_contacts.h) is written for more
+// contacts. The decode reads the sensor's two packet slots, and the report
+// layout above is core's two-finger report_digitizer_touchpad_t.
+_Static_assert(NT_MAX_CONTACTS == 2, "the pipeline and PTP report carry exactly two contacts");
+
+// Button masks
+#define BUTTON_PRIMARY          0x01
+
+// Tap-to-click configuration
+#ifndef TRACKPAD_TAP_TERM_MS
+#    define TRACKPAD_TAP_TERM_MS 200  // Maximum duration for a tap (ms)
+#endif
+
+#ifndef TRACKPAD_TAP_MOVE_THRESHOLD_SQ
+#    define TRACKPAD_TAP_MOVE_THRESHOLD_SQ 100  // Max movement squared before tap becomes drag
+#endif
+
+#ifndef TRACKPAD_TAP_SETTLE_TIME_MS
+#    define TRACKPAD_TAP_SETTLE_TIME_MS 30  // Ignore movement during initial contact (ms)
+#endif
+
+// Max allowed delta per frame. Only a guard against corrupt positions: a
+// change of the followed contact re-anchors instead, and the pad is under 1800
+// units across, so no real stroke comes near it.
+#ifndef TRACKPAD_MAX_DELTA
+#    define TRACKPAD_MAX_DELTA 1024
+#endif
+
+// The fallback follows the transformed contacts, in logical units, while the
+// settings above and the acceleration curve stay in sensor units: convert
+// (SENSOR_SCALE_X_MULT / 65536 logical units per sensor unit; the axes differ
+// by 0.3%).
+#define _NT_MOUSE_TAP_MOVE_SQ \
+    ((uint32_t)((uint64_t)TRACKPAD_TAP_MOVE_THRESHOLD_SQ * SENSOR_SCALE_X_MULT * SENSOR_SCALE_X_MULT >> 32))
+#define _NT_MOUSE_MAX_DELTA ((int16_t)(((uint32_t)TRACKPAD_MAX_DELTA * SENSOR_SCALE_X_MULT) >> 16))
+_Static_assert(_NT_MOUSE_MAX_DELTA <= NT_ACCEL_MAX_DELTA, "TRACKPAD_MAX_DELTA is past the acceleration table");
+
+// Fallback acceleration curve, SENSITIVITY * |delta|^ACCELERATION in Q8.8 with
+// delta in sensor units, built at compile time (see
+// navigator_trackpad_accel.h) for deltas in logical units.
+static const nt_accel_t mouse_accel =
+    NT_ACCEL_INIT(TRACKPAD_MOUSE_SENSITIVITY * __builtin_powf(65536.0f / SENSOR_SCALE_X_MULT, TRACKPAD_MOUSE_ACCELERATION),
+                  TRACKPAD_MOUSE_ACCELERATION);
+_Static_assert(NT_ACCEL_FITS(TRACKPAD_MOUSE_SENSITIVITY * __builtin_powf(65536.0f / SENSOR_SCALE_X_MULT, TRACKPAD_MOUSE_ACCELERATION),
+                             TRACKPAD_MOUSE_ACCELERATION),
+               "TRACKPAD_MOUSE_SENSITIVITY/ACCELERATION saturate the acceleration table");
+
+#if NAVIGATOR_TRACKPAD_SCROLL == TRUE
+static const nt_scroll_cfg_t scroll_cfg = {
+    NAVIGATOR_TRACKPAD_SCROLL_RESOLUTION,
+    NAVIGATOR_TRACKPAD_SCROLL_UNITS_PER_NOTCH,
+    NT_SCROLL_HV_MAX,
+    NAVIGATOR_TRACKPAD_SCROLL_NATURAL == TRUE,
+};
+#endif
+
+// Build a finger's 6 bytes into the report buffer
+// Format: [conf:1 + tip:1 + pad:6] [contact_id:3 + pad:5] [X_lo] [X_hi] [Y_lo] [Y_hi]
+static void build_finger_bytes(uint8_t *buf, uint8_t contact_id, uint16_t x, uint16_t y, bool tip, bool confidence) {
+    buf[0] = (confidence ? 0x01 : 0x00) | (tip ? 0x02 : 0x00);
+    buf[1] = contact_id & 0x07;  // contact_id in bits 0-2
+    buf[2] = x & 0xFF;           // X low byte
+    buf[3] = (x >> 8) & 0xFF;    // X high byte
+    buf[4] = y & 0xFF;           // Y low byte
+    buf[5] = (y >> 8) & 0xFF;    // Y high byte
+}
+
+#if NAVIGATOR_TRACKPAD_PTP_SUPPRESS_STATIONARY == TRUE
+// Whether a built PTP report says nothing new over the last one sent: the same
+// contacts at the same positions, the same count and buttons. The scan time
+// is left out, since it advances every frame.
+static bool ptp_report_repeats(const uint8_t *report, const uint8_t *last) {
+    return memcmp(report, last, PTP_SCAN_TIME_OFFSET) == 0 &&
+           report[PTP_COUNT_BUTTONS_OFFSET] == last[PTP_COUNT_BUTTONS_OFFSET];
+}
+#endif
+
+// Queue a fallback mouse report
+static void send_mouse_report(nt_pipeline_out_t *out, int16_t dx, int16_t dy, uint8_t buttons) {
+    if (out->mouse_count >= NT_PIPELINE_MAX_MOUSE_REPORTS) return;
+    out->mouse[out->mouse_count++] = (report_digitizer_touchpad_mouse_t){
+        .report_id = DIGITIZER_TOUCHPAD_MOUSE_REPORT_ID,
+        .buttons   = buttons,
+        .x         = dx,
+        .y         = dy
+    };
+}
+
+// Reset mouse state when mode changes to avoid stale timers/state
+static void reset_mouse_state(nt_mouse_fallback_t *ms, nt_pipeline_out_t *out) {
+    // Send release if button was pressed
+    if (ms->prev_buttons != 0 || ms->pending_release) {
+        send_mouse_report(out, 0, 0, 0);
+    }
+    ms->tracking = false;
+    ms->dx_accum = 0;
+    ms->dy_accum = 0;
+    ms->touch_start_time = 0;
+    ms->settled = false;
+    ms->is_drag = false;
+    ms->scrolled = false;
+    ms->pending_release = false;
+    ms->prev_buttons = 0;
+}
+
+// Clamp value to what one report can carry
+static inline int16_t clamp_to_report(int32_t value) {
+    if (value > NT_MOUSE_XY_MAX) return NT_MOUSE_XY_MAX;
+    if (value < -NT_MOUSE_XY_MAX) return -NT_MOUSE_XY_MAX;
+    return (int16_t)value;
+}
+
+bool nt_pipeline_pending(const nt_pipeline_t *st) {
+#if NAVIGATOR_TRACKPAD_SCROLL == TRUE
+    if (nt_scroll_pending(&st->scroll, &scroll_cfg)) return true;
+#endif
+    return st->mouse.dx_accum <= -256 || st->mouse.dx_accum >= 256 || st->mouse.dy_accum <= -256 ||
+           st->mouse.dy_accum >= 256;
+}
+
+// Process fallback mouse movement and tap-to-click
+// Uses settle time and movement suppression like navigator_trackpad_mouse for smooth operation.
+// Follows one contact of the emit list by host_id, so it sees the same
+// reconciled, corrected and smoothed positions as the PTP report: a contact
+// the sensor moves to another slot is still the same contact. scrolling: two
+// fingers are down and scrolling, so the cursor holds still.
+static void process_fallback_mouse(nt_mouse_fallback_t *ms, const nt_emit_list_t *emit, uint8_t sensor_buttons,
+                                   bool scrolling, uint32_t now, nt_pipeline_out_t *out) {
+    int16_t dx = 0;
+    int16_t dy = 0;
+    uint8_t buttons = 0;
+
+    // Handle pending click release from previous cycle (like mouse mode)
+    if (ms->pending_release) {
+        ms->pending_release = false;
+        send_mouse_report(out, 0, 0, 0);
+        ms->prev_buttons = 0;
+        // Continue processing - don't return early so we handle any new movement
+    }
+
+    // Handle physical button (from sensor)
+    if (sensor_buttons & BUTTON_PRIMARY) {
+        buttons |= BUTTON_PRIMARY;
+    }
+
+    // The contact to follow: the one followed so far while it stays down,
+    // otherwise the first one down.
+    const nt_emit_contact_t *c = NULL;
+    for (uint8_t i = 0; i < emit->count; i++) {
+        const nt_emit_contact_t *e = &emit->items[i];
+        if (!e->tip) continue;
+        if (c == NULL) c = e;
+        if (ms->tracking && e->host_id == ms->host_id) {
+            c = e;
+            break;
+        }
+    }
+    bool finger_down = c != NULL;
+
+    // Handle finger down transition (start tracking)
+    if (finger_down && !ms->tracking) {
+        ms->tracking = true;
+        ms->last_x  = c->x;
+        ms->last_y  = c->y;
+        ms->host_id = c->host_id;
+        // The accumulators are kept: motion still owed from the last stroke
+        // goes out rather than being dropped.
+        // Start tap detection with settle time approach
+        ms->touch_start_time = now;
+        ms->settled = false;
+        ms->settled_x = 0;
+        ms->settled_y = 0;
+        ms->is_drag = false;
+        ms->scrolled = false;
+    } else if (finger_down && c->host_id != ms->host_id) {
+        // The followed finger lifted while another stayed down: carry on from
+        // where that one is rather than jumping to it, and measure any tap
+        // movement from there too.
+        ms->last_x  = c->x;
+        ms->last_y  = c->y;
+        ms->host_id = c->host_id;
+        ms->settled = false;
+    }
+
+    if (scrolling) {
+        ms->scrolled = true;
+    }
+
+    // Handle finger movement
+    if (finger_down) {
+        uint32_t duration = now - ms->touch_start_time;
+
+        // Record settled position once settle time elapses (for tap detection)
+        if (!ms->settled && duration >= TRACKPAD_TAP_SETTLE_TIME_MS) {
+            ms->settled = true;
+            ms->settled_x = c->x;
+            ms->settled_y = c->y;
+        }
+
+        // Check if movement from settled position exceeds tap threshold → becomes a drag
+        if (ms->settled && !ms->is_drag) {
+            int16_t move_x = (int16_t)c->x - (int16_t)ms->settled_x;
+            int16_t move_y = (int16_t)c->y - (int16_t)ms->settled_y;
+            int32_t dist_sq = (int32_t)move_x * move_x + (int32_t)move_y * move_y;
+            if (dist_sq > (int32_t)_NT_MOUSE_TAP_MOVE_SQ) {
+                ms->is_drag = true;
+            }
+        }
+
+        // Only report movement once we've determined this is a drag (not a tap)
+        if (ms->is_drag && !ms->scrolled) {
+            // Already rotated: the transform turns the absolute points.
+            int16_t raw_dx = (int16_t)c->x - (int16_t)ms->last_x;
+            int16_t raw_dy = (int16_t)c->y - (int16_t)ms->last_y;
+
+            // Clamp deltas to prevent jumps from bad sensor data
+            if (raw_dx > _NT_MOUSE_MAX_DELTA) raw_dx = _NT_MOUSE_MAX_DELTA;
+            if (raw_dx < -_NT_MOUSE_MAX_DELTA) raw_dx = -_NT_MOUSE_MAX_DELTA;
+            if (raw_dy > _NT_MOUSE_MAX_DELTA) raw_dy = _NT_MOUSE_MAX_DELTA;
+            if (raw_dy < -_NT_MOUSE_MAX_DELTA) raw_dy = -_NT_MOUSE_MAX_DELTA;
+
+            // Apply configurable acceleration and sensitivity (table lookup)
+            // and accumulate for subpixel precision
+            ms->dx_accum += nt_accel_q8(&mouse_accel, raw_dx);
+            ms->dy_accum += nt_accel_q8(&mouse_accel, raw_dy);
+        }
+
+        // Always update last position for delta calculation
+        ms->last_x = c->x;
+        ms->last_y = c->y;
+    }
+
+    // Handle finger up transition (end tracking, check for tap)
+    if (!finger_down && ms->tracking) {
+        ms->tracking = false;
+
+        uint32_t touch_duration = now - ms->touch_start_time;
+
+        // Tap conditions: not a drag or a scroll AND short duration
+        bool is_tap = !ms->is_drag && !ms->scrolled && (touch_duration <= TRACKPAD_TAP_TERM_MS);
+
+        if (is_tap) {
+            // Valid tap - send click press, release will happen next cycle
+            send_mouse_report(out, 0, 0, BUTTON_PRIMARY);
+            ms->prev_buttons = BUTTON_PRIMARY;
+            ms->pending_release = true;
+        }
+
+        ms->settled = false;
+    }
+
+    // Report the whole counts accumulated, as many as one report carries, and
+    // keep the rest: the fraction for subpixel precision, and with 8-bit
+    // reports whatever a fast flick put past +/-127, which goes out over the
+    // following frames (after a lift too, see nt_pipeline_pending) so no
+    // motion is lost.
+    dx = clamp_to_report(ms->dx_accum / 256);
+    dy = clamp_to_report(ms->dy_accum / 256);
+    ms->dx_accum -= dx * 256;
+    ms->dy_accum -= dy * 256;
+
+    // Only send report if there's actual movement or button state changed
+    bool buttons_changed = (buttons != ms->prev_buttons);
+    bool has_movement = (dx != 0 || dy != 0);
+
+    if (has_movement || buttons_changed) {
+        send_mouse_report(out, dx, dy, buttons);
+        ms->prev_buttons = buttons;
+    }
+}
+
+#if NAVIGATOR_TRACKPAD_PTP_SMOOTHING == TRUE
+#    if NAVIGATOR_TRACKPAD_SMOOTHING_ADAPTIVE == TRUE
+static const nt_noise_cfg_t noise_cfg = {
+    NT_EURO_HZ_Q8(NAVIGATOR_TRACKPAD_SMOOTHING_MINCUTOFF),
+    NT_NOISE_VAR_Q4(NAVIGATOR_TRACKPAD_SMOOTHING_NOISE_REF),
+    NT_EURO_HZ_Q8(NAVIGATOR_TRACKPAD_SMOOTHING_MINCUTOFF_MIN),
+    NT_EURO_HZ_Q8(NAVIGATOR_TRACKPAD_SMOOTHING_MINCUTOFF_MAX),
+};
+#        define NT_MINCUTOFF_Q8(axis) ((uint32_t)st->noise.mincutoff_q8[axis])
+#    else
+#        define NT_MINCUTOFF_Q8(axis) NT_EURO_HZ_Q8(NAVIGATOR_TRACKPAD_SMOOTHING_MINCUTOFF)
+#    endif
+#endif
+
+#if NAVIGATOR_TRACKPAD_PROFILE == TRUE
+nt_profile_stat_t nt_profile_stats[NT_STAGE_COUNT];
+#endif
+
+void nt_pipeline_init(nt_pipeline_t *st, const nt_lut_t *lut) {
+    memset(st, 0, sizeof(*st));
+    st->lut             = lut;
+    st->prev_input_mode = TRACKPAD_INPUT_MODE_PTP;
+#if NAVIGATOR_TRACKPAD_PTP_SMOOTHING == TRUE && NAVIGATOR_TRACKPAD_SMOOTHING_ADAPTIVE == TRUE
+    st->noise = (nt_noise_t)NT_NOISE_INIT(NT_EURO_HZ_Q8(NAVIGATOR_TRACKPAD_SMOOTHING_MINCUTOFF),
+                                          NT_NOISE_VAR_Q4(NAVIGATOR_TRACKPAD_SMOOTHING_NOISE_REF));
+#endif
+}
+
+void nt_pipeline_process(nt_pipeline_t *st, const cgen6_report_t *frame, uint8_t input_mode, uint32_t now,
+                         nt_pipeline_out_t *out) {
+    memset(out, 0, sizeof(*out));
+    NT_PROFILE_MARK(prof);
+
+    // --- Contact assembly ---
+    // Gather currently-down contacts with the sensor's stable per-finger id. The
+    // Cirque keeps a finger's id constant even when it moves the contact to a
+    // different packet slot, so we key on id (not slot) to avoid teleporting/
+    // dropped contacts. Confidence is reported as-is (stays 1 for a real contact).
+    nt_sensor_contact_t cur[NT_MAX_CONTACTS];
+    uint8_t             cur_n = 0;
+    for (uint8_t ss = 0; ss < 2 && cur_n < NT_MAX_CONTACTS; ss++) {
+        if (frame->fingers[ss].tip) {
+            // Scale to logical units, subtract the calibrated geometric
+            // distortion field so straight physical strokes report straight
+            // (removes the ~1 mm diagonal bow), and rotate about the configured
+            // center, all in one pass with a single rounding. Both contacts
+            // share the center, so the rotation is rigid: their separation
+            // (used for two-finger gestures) is preserved.
+            uint16_t px, py;
+            NT_TRANSFORM_POINT(st->lut, frame->fingers[ss].x, frame->fingers[ss].y, px, py);
+            cur[cur_n].id   = frame->fingers[ss].id;
+            cur[cur_n].x    = px;
+            cur[cur_n].y    = py;
+            cur[cur_n].conf = frame->fingers[ss].confidence;
+            cur_n++;
+        }
+    }
+
+    NT_PROFILE_LAP(NT_STAGE_TRANSFORM, prof);
+
+    uint8_t buttons = frame->buttons & BUTTON_PRIMARY;
+    bool button_changed = (buttons != st->prev_buttons);
+
+#if COMMUNITY_MODULE_AUTOMOUSE_ENABLE == TRUE
+    // Feed primary-contact motion to automouse so a finger moving on the pad can
+    // activate the mouse layer. This runs regardless of input mode: in PTP mode
+    // the host derives cursor motion from the absolute contacts we emit, so there
+    // is no relative-delta report (send_mouse_report) for automouse to observe.
+    // Deltas are in logical units (0..TRACKPAD_LOGICAL_MAX); keyed on the sensor's
+    // stable contact id so a fresh touch doesn't produce a jump from a stale slot.
+    if (cur_n > 0) {
+        if (st->am_tracking && cur[0].id == st->am_prev_id) {
+            out->motion         = true;
+            out->motion_dx      = (int16_t)cur[0].x - (int16_t)st->am_prev_x;
+            out->motion_dy      = (int16_t)cur[0].y - (int16_t)st->am_prev_y;
+            out->motion_buttons = buttons;
+        }
+        st->am_tracking = true;
+        st->am_prev_id  = cur[0].id;
+        st->am_prev_x   = cur[0].x;
+        st->am_prev_y   = cur[0].y;
+    } else {
+        st->am_tracking = false;  // all fingers lifted; next touch starts fresh
+    }
+#endif
+
+    // Reconcile against what the host believes is down: continue still-present
+    // contacts, release (tip=0) any that vanished, and pick up new contacts as
+    // slots allow. Guarantees no contact is ever stranded on the host.
+    nt_emit_list_t emit;
+    nt_reconcile_contacts(&st->contacts, cur, cur_n, &emit);
+    NT_PROFILE_LAP(NT_STAGE_RECONCILE, prof);
+
+    uint8_t contact_count = emit.count;
+
+#if NAVIGATOR_TRACKPAD_PTP_SMOOTHING == TRUE
+    // Velocity-adaptive smoothing of the emitted absolute contacts, keyed by
+    // host_id (stable for a contact's lifetime). A host_id appearing with tip=1
+    // that was not down last frame is a fresh contact, so its filter is reset to
+    // seed at the true touch position (no startup ramp, no smear from a previous
+    // contact that reused the id). Released (tip=0) contacts pass through
+    // unfiltered and clear their slot.
+    {
+        // dt between emitted frames from the sensor's scan_time, falling back
+        // to the MCU timer if it stalls (see nt_frame_dt).
+#    if NAVIGATOR_TRACKPAD_SMOOTHING_FIXED_POINT == TRUE
+        nt_euro_fixed_dt_t dt;
+        nt_euro_fixed_dt(&dt, nt_frame_ticks(&st->filter_clock, frame->scan_time, now),
+                         NT_EURO_HZ_Q8(NAVIGATOR_TRACKPAD_SMOOTHING_DCUTOFF));
+#    else
+        float dt = nt_frame_dt(&st->filter_clock, frame->scan_time, now);
+#    endif
+
+        bool seen[NT_MAX_CONTACTS] = {0};
+        for (uint8_t i = 0; i < emit.count; i++) {
+            uint8_t id = emit.items[i].host_id;
+            if (id >= NT_MAX_CONTACTS) continue;  // defensive; host_ids are 0..1
+            if (!emit.items[i].tip) {
+                st->prev_emit_down[id] = false;       // release: drop history
+                continue;
+            }
+#    if NAVIGATOR_TRACKPAD_SMOOTHING_ADAPTIVE == TRUE
+            if (!st->prev_emit_down[id]) {
+                nt_noise_contact_reset(&st->noise_contact[id]);
+            }
+            nt_noise_update(&st->noise, &st->noise_contact[id], emit.items[i].x, emit.items[i].y, &noise_cfg);
+#    endif
+#    if NAVIGATOR_TRACKPAD_SMOOTHING_FIXED_POINT == TRUE
+            if (!st->prev_emit_down[id]) {
+                nt_euro_point_reset_fixed(&st->contact_filter[id]);
+            }
+            // Axis by axis: the adaptive mincutoff differs per axis.
+            int32_t ix = (nt_euro_axis_filter_fixed(&st->contact_filter[id].x, emit.items[i].x, &dt, NT_MINCUTOFF_Q8(0),
+                                                    NT_EURO_BETA_Q20(NAVIGATOR_TRACKPAD_SMOOTHING_BETA)) + 64) >> 7;
+            int32_t iy = (nt_euro_axis_filter_fixed(&st->contact_filter[id].y, emit.items[i].y, &dt, NT_MINCUTOFF_Q8(1),
+                                                    NT_EURO_BETA_Q20(NAVIGATOR_TRACKPAD_SMOOTHING_BETA)) + 64) >> 7;
+#    else
+            if (!st->prev_emit_down[id]) {
+                nt_euro_point_reset(&st->contact_filter[id]);
+            }
+            float fx = nt_euro_axis_filter(&st->contact_filter[id].x, (float)emit.items[i].x, dt,
+                                           NT_MINCUTOFF_Q8(0) / 256.0f, NAVIGATOR_TRACKPAD_SMOOTHING_BETA,
+                                           NAVIGATOR_TRACKPAD_SMOOTHING_DCUTOFF);
+            float fy = nt_euro_axis_filter(&st->contact_filter[id].y, (float)emit.items[i].y, dt,
+                                           NT_MINCUTOFF_Q8(1) / 256.0f, NAVIGATOR_TRACKPAD_SMOOTHING_BETA,
+                                           NAVIGATOR_TRACKPAD_SMOOTHING_DCUTOFF);
+            int32_t ix = (int32_t)(fx + 0.5f);
+            int32_t iy = (int32_t)(fy + 0.5f);
+#    endif
+            if (ix < 0) ix = 0;
+            if (ix > TRACKPAD_LOGICAL_MAX) ix = TRACKPAD_LOGICAL_MAX;
+            if (iy < 0) iy = 0;
+            if (iy > TRACKPAD_LOGICAL_MAX) iy = TRACKPAD_LOGICAL_MAX;
+            emit.items[i].x    = (uint16_t)ix;
+            emit.items[i].y    = (uint16_t)iy;
+            st->prev_emit_down[id] = true;
+            seen[id]           = true;
+        }
+        // Any slot not emitted this frame is no longer down.
+        for (uint8_t id = 0; id < NT_MAX_CONTACTS; id++) {
+            if (!seen[id]) st->prev_emit_down[id] = false;
+        }
+    }
+#endif
+
+#if NAVIGATOR_TRACKPAD_PTP_PREDICTION == TRUE
+    // Lead each down contact by its tracked velocity. A fresh contact seeds the
+    // predictor with no lead; a release is reported at the last unpredicted
+    // position, so the contact lifts where the finger was rather than where
+    // it was heading.
+    {
+        static const nt_predict_cfg_t cfg = {
+            NT_PREDICT_Q8(NAVIGATOR_TRACKPAD_PREDICTION_ALPHA),
+            NT_PREDICT_Q8(NAVIGATOR_TRACKPAD_PREDICTION_BETA),
+            NAVIGATOR_TRACKPAD_PREDICTION_MS * 10,
+            NAVIGATOR_TRACKPAD_PREDICTION_VMIN * 16,
+            NAVIGATOR_TRACKPAD_PREDICTION_MAX_LEAD,
+        };
+        uint16_t ticks = nt_frame_ticks(&st->predict_clock, frame->scan_time, now);
+
+        bool seen[NT_MAX_CONTACTS] = {0};
+        for (uint8_t i = 0; i < emit.count; i++) {
+            uint8_t id = emit.items[i].host_id;
+            if (id >= NT_MAX_CONTACTS) continue;
+            if (!emit.items[i].tip) {
+                if (st->prev_predict_down[id]) {
+                    emit.items[i].x = (uint16_t)st->contact_predict[id].x.last;
+                    emit.items[i].y = (uint16_t)st->contact_predict[id].y.last;
+                }
+                st->prev_predict_down[id] = false;
+                continue;
+            }
+            if (!st->prev_predict_down[id]) {
+                nt_predict_point_reset(&st->contact_predict[id]);
+            }
+            int32_t ix = emit.items[i].x;
+            int32_t iy = emit.items[i].y;
+            nt_predict_point(&st->contact_predict[id], &ix, &iy, ticks, &cfg);
+            if (ix < 0) ix = 0;
+            if (ix > TRACKPAD_LOGICAL_MAX) ix = TRACKPAD_LOGICAL_MAX;
+            if (iy < 0) iy = 0;
+            if (iy > TRACKPAD_LOGICAL_MAX) iy = TRACKPAD_LOGICAL_MAX;
+            emit.items[i].x       = (uint16_t)ix;
+            emit.items[i].y       = (uint16_t)iy;
+            st->prev_predict_down[id] = true;
+            seen[id]              = true;
+        }
+        for (uint8_t id = 0; id < NT_MAX_CONTACTS; id++) {
+            if (!seen[id]) st->prev_predict_down[id] = false;
+        }
+    }
+#endif
+
+    NT_PROFILE_LAP(NT_STAGE_FILTER, prof);
+
+    // Build report from the emit list (one finger per HID slot).
+    static const uint8_t finger_offset[NT_MAX_CONTACTS] = {PTP_FINGER0_OFFSET, PTP_FINGER1_OFFSET};
+    uint8_t *report = out->ptp;
+    report[0]       = PTP_REPORT_ID;
+    for (uint8_t i = 0; i < emit.count; i++) {
+        build_finger_bytes(&report[finger_offset[i]], emit.items[i].host_id,
+                           emit.items[i].x, emit.items[i].y, emit.items[i].tip, emit.items[i].conf);
+    }
+
+    // Scan time (2 bytes, little-endian)
+    report[PTP_SCAN_TIME_OFFSET]     = frame->scan_time & 0xFF;
+    report[PTP_SCAN_TIME_OFFSET + 1] = (frame->scan_time >> 8) & 0xFF;
+
+    // Contact count (bits 0-3) + buttons (bits 4-6)
+    report[PTP_COUNT_BUTTONS_OFFSET] = (contact_count & 0x0F) | ((buttons & BUTTON_PRIMARY) << 4);
+
+    // Handle input mode changes
+    if (input_mode != st->prev_input_mode) {
+        // Mode changed - reset mouse state to avoid stale timers/state
+        reset_mouse_state(&st->mouse, out);
+#if NAVIGATOR_TRACKPAD_SCROLL == TRUE
+        memset(&st->scroll, 0, sizeof(st->scroll));
+#endif
+        st->prev_input_mode = input_mode;
+    }
+
+    // PTP report only in PTP mode (mode 3)
+    if (input_mode == TRACKPAD_INPUT_MODE_PTP) {
+        out->ptp_send = contact_count > 0 || button_changed;
+#if NAVIGATOR_TRACKPAD_PTP_SUPPRESS_STATIONARY == TRUE
+        if (out->ptp_send && st->ptp_last_valid && ptp_report_repeats(report, st->ptp_last) &&
+            now - st->ptp_last_ms < NAVIGATOR_TRACKPAD_PTP_KEEPALIVE_MS) {
+            out->ptp_send       = false;
+            out->ptp_suppressed = true;
+        } else if (out->ptp_send) {
+            memcpy(st->ptp_last, report, NT_PIPELINE_PTP_REPORT_SIZE);
+            st->ptp_last_ms    = now;
+            st->ptp_last_valid = true;
+        }
+    } else {
+        st->ptp_last_valid = false;
+#endif
+    }
+
+    // Fallback mouse only in mouse mode (mode 0), from the same contacts
+    if (input_mode == TRACKPAD_INPUT_MODE_MOUSE) {
+#if NAVIGATOR_TRACKPAD_SCROLL == TRUE
+        bool scrolling = nt_scroll_update(&st->scroll, &emit, &scroll_cfg, &out->scroll_v, &out->scroll_h);
+        out->scroll    = out->scroll_v != 0 || out->scroll_h != 0;
+#else
+        bool scrolling = false;
+#endif
+        process_fallback_mouse(&st->mouse, &emit, buttons, scrolling, now, out);
+    }
+
+    // Update previous state
+    st->prev_buttons = buttons;
+
+    out->active = contact_count > 0 || button_changed;
+}
@@ -0,0 +1,302 @@
+// Copyright 2026 ZSA Technology Labs, Inc <contact@zsa.io>
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// The Navigator trackpad's frame pipeline: everything between a decoded sensor
+// frame and the reports sent to the host. Scale, distortion correction and
+// rotation (navigator_trackpad_transform.h), the automouse feed, contact
+// reconciliation (navigator_trackpad_contacts.h), smoothing and prediction, the
+// PTP report build, and the mouse-fallback path with its two-finger scroll
+// (navigator_trackpad_scroll.h), dispatched on the host's input mode.
+//
+// nt_pipeline_process() holds no hidden state and does no I/O: everything it
+// remembers between frames is in nt_pipeline_t, the time is passed in, and the
+// reports it would send come back in nt_pipeline_out_t. navigator_trackpad_ptp.c
+// owns the sensor transport and calls it once per frame; tools/nt_replay.c
+// feeds it recorded traces on the host.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "navigator_trackpad_common.h"
+#include "navigator_trackpad_contacts.h"
+#include "navigator_trackpad_filter.h"
+#include "navigator_trackpad_lut.h"
+#include "navigator_trackpad_predict.h"
+#include "navigator_trackpad_scroll.h"
+#include "report.h"
+
+// Input mode values (set by host via HID feature report)
+#define TRACKPAD_INPUT_MODE_MOUSE 0
+#define TRACKPAD_INPUT_MODE_PTP   3
+
+// --- PTP coordinate smoothing (One Euro filter) ---------------------------
+// Velocity-adaptive low-pass on the absolute contacts we emit in PTP mode:
+// smooths hard when the finger is nearly still (kills sensor jitter so straight
+// lines and slow circles stop wobbling) and backs off to near-passthrough when
+// moving fast (so quick strokes stay crisp instead of feeling laggy/floaty —
+// the failure mode of a plain fixed IIR). Set NAVIGATOR_TRACKPAD_PTP_SMOOTHING
+// to FALSE to A/B against raw passthrough.
+//
+// Tuning (coordinates are in logical units 0..TRACKPAD_LOGICAL_MAX, speed in
+// units/second): MINCUTOFF sets how hard we smooth when still (lower =
+// smoother, more low-speed lag); BETA sets how quickly smoothing relaxes as
+// speed rises (higher = passthrough sooner = less lag while moving).
+#ifndef NAVIGATOR_TRACKPAD_PTP_SMOOTHING
+#    define NAVIGATOR_TRACKPAD_PTP_SMOOTHING TRUE
+#endif
+// Defaults tuned on the captured Linux/libinput jitter trace (~125 Hz, +/-8 unit
+// noise floor) and refined on-pad toward less lag: ~74% jitter reduction at rest
+// with ~0.2 frame (~0.75 mm) lag on a fast stroke. DCUTOFF is deliberately well
+// above the classic 1 Hz so the speed estimate tracks within a frame — at 1 Hz a
+// quick stroke lags ~3 frames and feels floaty, the exact failure of the earlier
+// fixed IIR. To trade smoothness for even less lag, raise BETA (and DCUTOFF a
+// little); e.g. 0.010 / 18 gives ~69% / ~0.5 mm.
+#ifndef NAVIGATOR_TRACKPAD_SMOOTHING_MINCUTOFF
+#    define NAVIGATOR_TRACKPAD_SMOOTHING_MINCUTOFF 1.5f
+#endif
+#ifndef NAVIGATOR_TRACKPAD_SMOOTHING_BETA
+#    define NAVIGATOR_TRACKPAD_SMOOTHING_BETA 0.0070f
+#endif
+#ifndef NAVIGATOR_TRACKPAD_SMOOTHING_DCUTOFF
+#    define NAVIGATOR_TRACKPAD_SMOOTHING_DCUTOFF 15.0f
+#endif
+// Adapt MINCUTOFF to the pad's own noise floor, estimated while a contact
+// rests (see nt_noise_update): quiet units get less lag, noisy units less
+// wobble. NOISE_REF is the jitter variance (units^2) the defaults above were
+// tuned at (+/-8 units, uniform); the cutoff stays within MIN..MAX Hz.
+#ifndef NAVIGATOR_TRACKPAD_SMOOTHING_ADAPTIVE
+#    define NAVIGATOR_TRACKPAD_SMOOTHING_ADAPTIVE TRUE
+#endif
+#ifndef NAVIGATOR_TRACKPAD_SMOOTHING_NOISE_REF
+#    define NAVIGATOR_TRACKPAD_SMOOTHING_NOISE_REF 21.3f
+#endif
+#ifndef NAVIGATOR_TRACKPAD_SMOOTHING_MINCUTOFF_MIN
+#    define NAVIGATOR_TRACKPAD_SMOOTHING_MINCUTOFF_MIN 0.5f
+#endif
+#ifndef NAVIGATOR_TRACKPAD_SMOOTHING_MINCUTOFF_MAX
+#    define NAVIGATOR_TRACKPAD_SMOOTHING_MINCUTOFF_MAX 4.0f
+#endif
+// Run the filter in integer arithmetic (nt_euro_*_fixed, within one logical
+// unit of the float version). Defaults to TRUE on parts without a hardware
+// FPU, where every float operation is a soft-float library call.
+#ifndef NAVIGATOR_TRACKPAD_SMOOTHING_FIXED_POINT
+#    if defined(__AVR__) || (defined(__arm__) && !defined(__ARM_FP))
+#        define NAVIGATOR_TRACKPAD_SMOOTHING_FIXED_POINT TRUE
+#    else
+#        define NAVIGATOR_TRACKPAD_SMOOTHING_FIXED_POINT FALSE
+#    endif
+#endif
+
+// --- PTP motion prediction -------------------------------------------------
+// Project each emitted contact forward along its tracked velocity to make up
+// for the sensor frame, poll and USB latency (see navigator_trackpad_predict.h).
+// Runs after the smoothing filter. Off by default: it trades a little overshoot
+// at sharp stops for less trailing on fast strokes.
+//
+// PREDICTION_MS is the lead time. On the synthetic strokes in
+// tests/predict_test.c, 8 ms cuts the lag behind the finger by about a third
+// with at most ~5 units (0.1 mm) of overshoot; 12 ms cuts it by half but
+// overshoots a sharp turn by ~15 units. MAX_LEAD caps the lead per axis.
+#ifndef NAVIGATOR_TRACKPAD_PTP_PREDICTION
+#    define NAVIGATOR_TRACKPAD_PTP_PREDICTION FALSE
+#endif
+#ifndef NAVIGATOR_TRACKPAD_PREDICTION_MS
+#    define NAVIGATOR_TRACKPAD_PREDICTION_MS 8
+#endif
+#ifndef NAVIGATOR_TRACKPAD_PREDICTION_MAX_LEAD
+#    define NAVIGATOR_TRACKPAD_PREDICTION_MAX_LEAD 64
+#endif
+// Tracker gains and the speed (units/s) below which there is no lead.
+#ifndef NAVIGATOR_TRACKPAD_PREDICTION_ALPHA
+#    define NAVIGATOR_TRACKPAD_PREDICTION_ALPHA 0.5f
+#endif
+#ifndef NAVIGATOR_TRACKPAD_PREDICTION_BETA
+#    define NAVIGATOR_TRACKPAD_PREDICTION_BETA 0.15f
+#endif
+#ifndef NAVIGATOR_TRACKPAD_PREDICTION_VMIN
+#    define NAVIGATOR_TRACKPAD_PREDICTION_VMIN 400
+#endif
+
+// --- PTP report change detection --------------------------------------------
+// Skip a PTP report that repeats the last one sent (scan time aside): with the
+// smoothing filter settled, a resting finger otherwise sends an identical
+// report every sensor frame, each one a USB transaction and a host wakeup.
+// KEEPALIVE_MS bounds the gap, so a contact that stays down is still reported
+// at that rate and neither Windows nor libinput ever sees it go quiet. Any
+// change — a move, a lift, a button — is sent at once.
+#ifndef NAVIGATOR_TRACKPAD_PTP_SUPPRESS_STATIONARY
+#    define NAVIGATOR_TRACKPAD_PTP_SUPPRESS_STATIONARY TRUE
+#endif
+#ifndef NAVIGATOR_TRACKPAD_PTP_KEEPALIVE_MS
+#    define NAVIGATOR_TRACKPAD_PTP_KEEPALIVE_MS 50
+#endif
+
+// --- Two-finger scroll in mouse mode ----------------------------------------
+// With the host left in mouse mode, two fingers down scroll instead of moving
+// the cursor (see navigator_trackpad_scroll.h). The wheel and pan go out in
+// QMK's mouse report, so this needs MOUSE_ENABLE; with
+// POINTING_DEVICE_HIRES_SCROLL_ENABLE that report declares the HID resolution
+// multiplier and scrolling is smooth rather than notched. RESOLUTION is the
+// counts per notch the host expects: set it to match if you change
+// POINTING_DEVICE_HIRES_SCROLL_EXPONENT. UNITS_PER_NOTCH is the finger travel
+// per notch in logical units (128 is ~2.5 mm); NATURAL moves the content with
+// the fingers, as Windows and macOS touchpads do by default.
+#ifndef NAVIGATOR_TRACKPAD_SCROLL
+#    define NAVIGATOR_TRACKPAD_SCROLL FALSE
+#endif
+#ifndef NAVIGATOR_TRACKPAD_SCROLL_UNITS_PER_NOTCH
+#    define NAVIGATOR_TRACKPAD_SCROLL_UNITS_PER_NOTCH 128
+#endif
+#ifndef NAVIGATOR_TRACKPAD_SCROLL_RESOLUTION
+#    if defined(POINTING_DEVICE_HIRES_SCROLL_ENABLE) && defined(POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER)
+#        define NAVIGATOR_TRACKPAD_SCROLL_RESOLUTION POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER
+#    elif defined(POINTING_DEVICE_HIRES_SCROLL_ENABLE)
+#        define NAVIGATOR_TRACKPAD_SCROLL_RESOLUTION 120
+#    else
+#        define NAVIGATOR_TRACKPAD_SCROLL_RESOLUTION 1
+#    endif
+#endif
+#ifndef NAVIGATOR_TRACKPAD_SCROLL_NATURAL
+#    define NAVIGATOR_TRACKPAD_SCROLL_NATURAL TRUE
+#endif
+
+// Wheel counts are 16-bit with WHEEL_EXTENDED_REPORT, 8-bit otherwise.
+#ifdef WHEEL_EXTENDED_REPORT
+#    define NT_SCROLL_HV_MAX 32767
+#else
+#    define NT_SCROLL_HV_MAX 127
+#endif
+
+// Largest delta one fallback mouse report carries. The report and its
+// descriptor are core's (8-bit x/y today, whatever MOUSE_EXTENDED_REPORT
+// says), so the limit follows the field's declared width.
+#define NT_MOUSE_XY_MAX \
+    ((int16_t)((1u << (8 * sizeof(((report_digitizer_touchpad_mouse_t *)0)->x) - 1)) - 1))
+
+#define NT_PIPELINE_PTP_REPORT_SIZE 16
+#define NT_PIPELINE_MAX_MOUSE_REPORTS 4
+
+// Fallback mouse state
+typedef struct {
+    // Position tracking for relative movement: the followed contact (by
+    // host_id) and its last position, in logical units
+    bool     tracking;
+    uint8_t  host_id;
+    uint16_t last_x;
+    uint16_t last_y;
+    // Motion not yet reported (Q8.8 counts): the subpixel remainder, and with
+    // 8-bit reports any overflow still to go out
+    int32_t  dx_accum;
+    int32_t  dy_accum;
+    // Tap detection - uses settled position like mouse mode
+    uint32_t touch_start_time;
+    uint16_t settled_x;
+    uint16_t settled_y;
+    bool     settled;
+    bool     is_drag;  // Set when movement exceeds tap threshold - enables cursor movement
+    bool     scrolled;  // Two fingers scrolled this touch: no cursor motion or tap until all lift
+    // Click state - pending_release triggers button release on next cycle
+    bool     pending_release;
+    // Previous state for change detection
+    uint8_t  prev_buttons;
+} nt_mouse_fallback_t;
+
+// Everything the pipeline carries from one frame to the next.
+typedef struct {
+    // Distortion table for the transform: the compiled one, a per-unit table
+    // loaded from EEPROM, or NULL for none.
+    const nt_lut_t *lut;
+    // Contacts the host currently believes are down, keyed to the sensor's
+    // stable per-finger id. Reconciled against each frame so every lifted
+    // contact gets a clean tip=0 and none is ever stranded (see
+    // navigator_trackpad_contacts.h).
+    nt_contact_state_t contacts;
+    uint8_t            prev_buttons;
+    // Input mode of the previous frame, to detect changes.
+    uint8_t             prev_input_mode;
+    nt_mouse_fallback_t mouse;
+#if NAVIGATOR_TRACKPAD_SCROLL == TRUE
+    nt_scroll_t scroll;
+#endif
+#if COMMUNITY_MODULE_AUTOMOUSE_ENABLE == TRUE
+    // Primary contact of the previous frame, for the automouse motion feed.
+    bool     am_tracking;
+    uint8_t  am_prev_id;
+    uint16_t am_prev_x;
+    uint16_t am_prev_y;
+#endif
+#if NAVIGATOR_TRACKPAD_PTP_SMOOTHING == TRUE
+    // Per-emitted-slot One Euro filter state, the slot's down-flag from last
+    // frame (a rising edge means a fresh contact -> reset the filter), and the
+    // previous frame's timestamps used to derive the filter's dt.
+#    if NAVIGATOR_TRACKPAD_SMOOTHING_FIXED_POINT == TRUE
+    nt_euro_point_fixed_t contact_filter[NT_MAX_CONTACTS];
+#    else
+    nt_euro_point_t contact_filter[NT_MAX_CONTACTS];
+#    endif
+    bool             prev_emit_down[NT_MAX_CONTACTS];
+    nt_frame_clock_t filter_clock;
+#    if NAVIGATOR_TRACKPAD_SMOOTHING_ADAPTIVE == TRUE
+    // Pad-wide noise estimate (per axis) and the per-slot stationarity state
+    // feeding it.
+    nt_noise_t         noise;
+    nt_noise_contact_t noise_contact[NT_MAX_CONTACTS];
+#    endif
+#endif
+#if NAVIGATOR_TRACKPAD_PTP_PREDICTION == TRUE
+    // Per-emitted-slot predictor state, keyed like the filter above.
+    nt_predict_point_t contact_predict[NT_MAX_CONTACTS];
+    bool               prev_predict_down[NT_MAX_CONTACTS];
+    nt_frame_clock_t   predict_clock;
+#endif
+#if NAVIGATOR_TRACKPAD_PTP_SUPPRESS_STATIONARY == TRUE
+    // The last PTP report sent and when, for change detection; ptp_last_valid
+    // is cleared outside PTP mode so the first report back is always sent.
+    bool     ptp_last_valid;
+    uint32_t ptp_last_ms;
+    uint8_t  ptp_last[NT_PIPELINE_PTP_REPORT_SIZE];
+#endif
+} nt_pipeline_t;
+
+// What one frame produces, in the order the caller should act on it.
+typedef struct {
+#if COMMUNITY_MODULE_AUTOMOUSE_ENABLE == TRUE
+    // Primary-contact motion for automouse_report_motion().
+    bool    motion;
+    int16_t motion_dx;
+    int16_t motion_dy;
+    uint8_t motion_buttons;
+#endif
+    // Fallback mouse reports, sent first.
+    uint8_t                           mouse_count;
+    report_digitizer_touchpad_mouse_t mouse[NT_PIPELINE_MAX_MOUSE_REPORTS];
+#if NAVIGATOR_TRACKPAD_SCROLL == TRUE
+    // Two-finger scroll for the mouse report, when scroll: wheel (positive
+    // up) and pan (positive right) counts.
+    bool    scroll;
+    int16_t scroll_v;
+    int16_t scroll_h;
+#endif
+    // The PTP report (report_digitizer_touchpad_t layout), when ptp_send.
+    // ptp_suppressed marks a report skipped as a repeat of the last one.
+    bool    ptp_send;
+    bool    ptp_suppressed;
+    uint8_t ptp[NT_PIPELINE_PTP_REPORT_SIZE];
+    // Contacts down or a button changed (the task's return value).
+    bool active;
+} nt_pipeline_out_t;
+
+// Reset to power-on state with the given distortion table.
+void nt_pipeline_init(nt_pipeline_t *st, const nt_lut_t *lut);
+
+// Whether the pipeline still has output to send with no new sensor data: the
+// fallback mouse's unreported motion and scroll. The caller keeps running lift-off
+// (zeroed) frames through while this holds.
+bool nt_pipeline_pending(const nt_pipeline_t *st);
+
+// Run one sensor frame (a zeroed frame for a confirmed lift-off) through the
+// pipeline. input_mode is the host's current TRACKPAD_INPUT_MODE_*; now is the
+// MCU time in ms.
+void nt_pipeline_process(nt_pipeline_t *st, const cgen6_report_t *frame, uint8_t input_mode, uint32_t now,
+                         nt_pipeline_out_t *out);
@@ -0,0 +1,103 @@
+// Copyright 2026 ZSA Technology Labs, Inc <contact@zsa.io>
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// Latency-compensating motion prediction for the Navigator trackpad PTP path.
+//
+// Between the finger and the cursor sit the sensor frame (~8 ms), the poll,
+// the USB interval and the One Euro filter's own ~0.2 frame of lag. On a fast
+// stroke that adds up to several millimetres of trailing. This stage projects
+// each contact forward by a fixed horizon along its tracked velocity.
+//
+// The velocity comes from an alpha-beta tracker run on the filtered positions,
+// clocked by the same scan_time dt as the filter. Prediction only helps while
+// motion continues, so the lead is held back where it would overshoot:
+//   - below vmin the lead shrinks smoothly to zero, so a resting or
+//     slowly moving finger gets no amplified jitter;
+//   - when an axis reverses direction its velocity is dropped, and when it
+//     slows down the velocity never exceeds this frame's step, so a zigzag or
+//     the end of a flick does not sail past the turning point;
+//   - the lead is capped per axis (max_lead units);
+//   - on lift the caller reports the unpredicted position (x.last, y.last), so
+//     the contact is released where the finger actually was.
+//
+// Integer arithmetic only, so it costs the same with or without an FPU:
+//   position   Q8 logical units
+//   velocity   Q4 logical units per second
+//   dt         scan_time ticks (100 us), as from nt_frame_ticks()
+//   alpha/beta Q8
+//
+// Pure and host-testable (tests/predict_test.c).
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define NT_PREDICT_Q8(v) ((int32_t)((v) * 256.0f + 0.5f))
+#define NT_PREDICT_V_MAX (40000 * 16)  // +/-40000 units/s, far above any stroke
+
+typedef struct {
+    int32_t alpha_q8;  // position gain of the tracker
+    int32_t beta_q8;   // velocity gain of the tracker
+    int32_t horizon;   // lead time, scan_time ticks (up to 500)
+    int32_t vmin_q4;   // speed below which there is no lead, Q4 units/s
+    int32_t max_lead;  // cap on the lead per axis, units
+} nt_predict_cfg_t;
+
+typedef struct {
+    int32_t x;     // tracked position, Q8
+    int32_t v;     // tracked velocity, Q4 units/s
+    int32_t last;  // last input, units
+} nt_predict_axis_t;
+
+typedef struct {
+    nt_predict_axis_t x;
+    nt_predict_axis_t y;
+    bool              init;  // false until the first sample seeds the tracker
+} nt_predict_point_t;
+
+// Track one axis sample and return the lead to add to it, in units.
+static inline int32_t nt_predict_axis(nt_predict_axis_t *a, int32_t z, uint16_t ticks, const nt_predict_cfg_t *cfg) {
+    int32_t step = z - a->last;
+    if ((step > 0 && a->v < 0) || (step < 0 && a->v > 0)) {
+        a->v = 0;  // direction reversal: no momentum past the turn
+    } else {
+        // Slowing down: never carry more speed than this frame's step shows.
+        int32_t vs = step * 160000 / (int32_t)ticks;
+        if (a->v > vs && vs >= 0) a->v = vs;
+        if (a->v < vs && vs <= 0) a->v = vs;
+    }
+    a->last = z;
+
+    int32_t pred = a->x + a->v * (int32_t)ticks / 625;  // v * dt, Q4/s -> Q8
+    int32_t r    = (z << 8) - pred;
+    a->x         = pred + ((cfg->alpha_q8 * r) >> 8);
+    a->v += ((cfg->beta_q8 * r) >> 8) * 625 / (int32_t)ticks;
+    if (a->v > NT_PREDICT_V_MAX) a->v = NT_PREDICT_V_MAX;
+    if (a->v < -NT_PREDICT_V_MAX) a->v = -NT_PREDICT_V_MAX;
+
+    // Soft threshold: the lead grows from zero at vmin, with no step.
+    int32_t speed = (a->v < 0 ? -a->v : a->v) - cfg->vmin_q4;
+    if (speed <= 0) return 0;
+    int32_t lead = (speed * cfg->horizon / 625 + 128) >> 8;
+    if (lead > cfg->max_lead) lead = cfg->max_lead;
+    return a->v < 0 ? -lead : lead;
+}
+
+// Predict an (x, y) point in place. The caller clamps to the logical range.
+static inline void nt_predict_point(nt_predict_point_t *p, int32_t *x, int32_t *y, uint16_t ticks,
+                                    const nt_predict_cfg_t *cfg) {
+    if (!p->init) {
+        p->x    = (nt_predict_axis_t){.x = *x << 8, .last = *x};
+        p->y    = (nt_predict_axis_t){.x = *y << 8, .last = *y};
+        p->init = true;
+        return;
+    }
+    *x += nt_predict_axis(&p->x, *x, ticks, cfg);
+    *y += nt_predict_axis(&p->y, *y, ticks, cfg);
+}
+
+// Forget all history so the next sample seeds fresh (call on a new contact).
+static inline void nt_predict_point_reset(nt_predict_point_t *p) {
+    *p = (nt_predict_point_t){0};
+}
@@ -0,0 +1,109 @@
+// Copyright 2026 ZSA Technology Labs, Inc <contact@zsa.io>
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// Optional per-stage timing of the trackpad task, to tell where the time of a
+// frame goes: the bus read, the decode, the transform, reconciliation, the
+// filter (smoothing and prediction) and the USB send. Off by default; with
+// NAVIGATOR_TRACKPAD_PROFILE = FALSE every NT_PROFILE_* macro compiles away.
+//
+// Each stage keeps its count, min, mean and max and a histogram with base-4
+// bins, in NT_PROFILE_NOW() ticks: CPU cycles from the DWT counter on
+// Cortex-M3 and up. Other targets, and the host tests (which use the mock
+// bus's fake clock), define NT_PROFILE_NOW() and NT_PROFILE_UNIT themselves.
+// navigator_trackpad_profile_dump() prints the table to the console, and
+// navigator_trackpad_profile_pack() packs one stage for a raw HID reply.
+//
+// nt_profile_record() is pure and host-testable (tests/profile_test.c).
+
+#pragma once
+
+#include <stdint.h>
+
+#ifndef NAVIGATOR_TRACKPAD_PROFILE
+#    define NAVIGATOR_TRACKPAD_PROFILE FALSE
+#endif
+
+typedef enum {
+    NT_STAGE_READ,       // issuing the report read (the bus transfer)
+    NT_STAGE_DECODE,     // collecting and decoding the packet
+    NT_STAGE_TRANSFORM,  // scale, LUT and rotation of the contacts
+    NT_STAGE_RECONCILE,  // contact reconciliation
+    NT_STAGE_FILTER,     // smoothing, noise estimate and prediction
+    NT_STAGE_SEND,       // the USB sends
+    NT_STAGE_FRAME,      // the whole task call that handled a frame, also
+                         // covering the report build and mode dispatch
+    NT_STAGE_COUNT,
+} nt_profile_stage_t;
+
+// Bin 0 holds 0 ticks; bin k >= 1 holds [4^(k-1), 4^k), the last one open.
+#define NT_PROFILE_BINS 15
+
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint16_t hist[NT_PROFILE_BINS];  // saturating
+} nt_profile_stat_t;
+
+static inline uint8_t nt_profile_bin(uint32_t ticks) {
+    uint8_t bits = 0;
+    while (ticks) {
+        bits++;
+        ticks >>= 1;
+    }
+    uint8_t bin = (bits + 1) / 2;
+    return bin < NT_PROFILE_BINS ? bin : NT_PROFILE_BINS - 1;
+}
+
+static inline void nt_profile_record(nt_profile_stat_t *s, uint32_t ticks) {
+    if (s->count == 0 || ticks < s->min) s->min = ticks;
+    if (ticks > s->max) s->max = ticks;
+    s->count++;
+    s->sum += ticks;
+    uint16_t *h = &s->hist[nt_profile_bin(ticks)];
+    if (*h != UINT16_MAX) (*h)++;
+}
+
+static inline uint32_t nt_profile_mean(const nt_profile_stat_t *s) {
+    return s->count ? (uint32_t)(s->sum / s->count) : 0;
+}
+
+#if NAVIGATOR_TRACKPAD_PROFILE == TRUE
+#    ifndef NT_PROFILE_NOW
+#        if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+#            define NT_PROFILE_DWT
+#            define NT_PROFILE_NOW() (*(volatile uint32_t *)0xE0001004u)  // DWT->CYCCNT
+#            define NT_PROFILE_UNIT "cycles"
+#        else
+#            error "NAVIGATOR_TRACKPAD_PROFILE needs a cycle counter on this target: define NT_PROFILE_NOW()"
+#        endif
+#    endif
+#    ifndef NT_PROFILE_UNIT
+#        define NT_PROFILE_UNIT "ticks"
+#    endif
+
+// Start the clock (once, before the first frame).
+static inline void nt_profile_clock_init(void) {
+#    ifdef NT_PROFILE_DWT
+    *(volatile uint32_t *)0xE000EDFCu |= 1u << 24;  // CoreDebug->DEMCR |= TRCENA
+    *(volatile uint32_t *)0xE0001000u |= 1u;        // DWT->CTRL |= CYCCNTENA
+#    endif
+}
+
+// Defined in navigator_trackpad_pipeline.c.
+extern nt_profile_stat_t nt_profile_stats[NT_STAGE_COUNT];
+
+// NT_PROFILE_MARK(t) starts a lap timer t; NT_PROFILE_LAP(stage, t) charges the
+// time since to stage and restarts t, so consecutive stages chain.
+#    define NT_PROFILE_MARK(t) uint32_t t = NT_PROFILE_NOW()
+#    define NT_PROFILE_LAP(stage, t)                                       \
+        do {                                                               \
+            uint32_t nt_profile_now_ = NT_PROFILE_NOW();                   \
+            nt_profile_record(&nt_profile_stats[stage], nt_profile_now_ - (t)); \
+            (t) = nt_profile_now_;                                         \
+        } while (0)
+#else
+#    define NT_PROFILE_MARK(t) ((void)0)
+#    define NT_PROFILE_LAP(stage, t) ((void)0)
+#endif
@@ -6,6 +6,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "navigator_trackpad_common.h"
+#include "navigator_trackpad_profile.h"
 #include "report.h"
 
 // Mouse fallback mode configuration (when host doesn't support PTP)
@@ -21,3 +22,24 @@
 
 // PTP task function - called by navigator_trackpad.c each cycle
 bool navigator_trackpad_ptp_task(void);
+
+// Per-unit distortion table (NAVIGATOR_TRACKPAD_LUT_EEPROM). load() reads the
+// stored table once, falling back to the compiled one; returns true if a valid
+// table was found. save() validates a blob from tools/nt_lut_fit, stores it and
+// loads it. Both return false when the feature is disabled.
+bool navigator_trackpad_lut_load(void);
+bool navigator_trackpad_lut_save(const uint8_t *blob, uint16_t len);
+
+#if NAVIGATOR_TRACKPAD_PROFILE == TRUE
+// Per-stage timing (see navigator_trackpad_profile.h). get() returns a stage's
+// counters, or NULL past NT_STAGE_COUNT; clear() restarts them. dump() prints
+// every stage to the console. pack() writes one stage into buf for a raw HID
+// reply: stage, then count, min, mean and max as little-endian uint32, then
+// each histogram bin's share of the samples (255 = all). It returns the bytes
+// written, or 0 for a bad stage or a buffer under NT_PROFILE_PACK_SIZE.
+#    define NT_PROFILE_PACK_SIZE (17 + NT_PROFILE_BINS)
+const nt_profile_stat_t *navigator_trackpad_profile_get(uint8_t stage);
+void                     navigator_trackpad_profile_clear(void);
+void                     navigator_trackpad_profile_dump(void);
+uint8_t                  navigator_trackpad_profile_pack(uint8_t stage, uint8_t *buf, uint8_t len);
+#endif
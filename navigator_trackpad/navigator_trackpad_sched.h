@@ -0,0 +1,135 @@
+// Copyright 2026 ZSA Technology Labs, Inc <contact@zsa.io>
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// Adaptive poll scheduler for the Navigator trackpad polling path.
+//
+// The Cirque streams a frame roughly every 8 ms while a finger is down and
+// goes quiet otherwise. A fixed 5 ms poll both oversamples a held finger
+// (a third of the reads come back empty) and delivers each frame up to a whole
+// poll interval late, and while idle it keeps the bus busy 200 times a second
+// for nothing.
+//
+// While touching, the scheduler locks onto the sensor's frame period, measured
+// from scan_time deltas (100 us units), and aims each poll at the next frame:
+// a frame picked up on the first try means we may be late, so the next poll
+// goes out 1 ms early; an empty poll means the frame is imminent, so it is
+// retried after 1 ms. That settles at under 1 ms of delivery delay with about
+// 1.5 polls per frame. Once no contact is tracked, polling backs off in tiers
+// (5 -> 20 -> 50 ms by default) and snaps back to the locked cadence on the
+// first frame that arrives.
+//
+// Pure and host-testable — no hardware or QMK dependencies (see tests/).
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Poll interval when the frame period is not known yet, and for the first
+// NT_SCHED_IDLE_HOLD_MS after the last contact lifts.
+#ifndef NT_SCHED_BASE_MS
+#    define NT_SCHED_BASE_MS 5
+#endif
+// Idle back-off tiers: after NT_SCHED_IDLE_HOLD_MS of idle polling the
+// interval rises to NT_SCHED_IDLE_MID_MS, and after NT_SCHED_IDLE_DEEP_AFTER_MS
+// to NT_SCHED_IDLE_DEEP_MS. The deepest tier bounds the touch-down latency
+// after a long idle.
+#ifndef NT_SCHED_IDLE_HOLD_MS
+#    define NT_SCHED_IDLE_HOLD_MS 250
+#endif
+#ifndef NT_SCHED_IDLE_MID_MS
+#    define NT_SCHED_IDLE_MID_MS 20
+#endif
+#ifndef NT_SCHED_IDLE_DEEP_AFTER_MS
+#    define NT_SCHED_IDLE_DEEP_AFTER_MS 2000
+#endif
+#ifndef NT_SCHED_IDLE_DEEP_MS
+#    define NT_SCHED_IDLE_DEEP_MS 50
+#endif
+
+// Plausible frame periods, in scan_time units (100 us). Deltas outside this
+// range (the first frame after an idle gap, a wrapped or zero scan_time) are
+// not used for the estimate.
+#define NT_SCHED_PERIOD_MIN 20
+#define NT_SCHED_PERIOD_MAX 250
+
+typedef struct {
+    uint16_t period;      // smoothed frame period (100 us units), 0 = unknown
+    uint16_t last_scan;   // scan_time of the last frame
+    bool     have_scan;   // last_scan is from the previous frame (no gap)
+    uint8_t  misses;      // empty polls since the last frame while touching
+    uint16_t idle_ms;     // time spent idle-polling since the last frame
+    uint16_t interval;    // delay before the next poll (ms)
+} nt_sched_t;
+
+static inline void nt_sched_init(nt_sched_t *s) {
+    *s          = (nt_sched_t){0};
+    s->interval = NT_SCHED_BASE_MS;
+}
+
+// Delay, in ms after the previous poll was issued, before the next is due.
+static inline uint16_t nt_sched_interval(const nt_sched_t *s) {
+    return s->interval;
+}
+
+static inline uint16_t nt_sched_period_ms(const nt_sched_t *s) {
+    uint16_t ms = s->period / 10;
+    return ms > 1 ? ms : 1;
+}
+
+// The poll returned a frame carrying `scan_time`.
+static inline void nt_sched_frame(nt_sched_t *s, uint16_t scan_time) {
+    if (s->have_scan) {
+        uint16_t d = (uint16_t)(scan_time - s->last_scan);
+        // Reject a missed frame (about twice the period) once locked.
+        if (d >= NT_SCHED_PERIOD_MIN && d <= NT_SCHED_PERIOD_MAX && (s->period == 0 || d < s->period + s->period / 2)) {
+            s->period = s->period == 0 ? d : (uint16_t)((3 * s->period + d + 2) / 4);
+        }
+    }
+    s->last_scan = scan_time;
+    s->have_scan = true;
+    s->idle_ms   = 0;
+
+    if (s->period == 0) {
+        s->interval = NT_SCHED_BASE_MS;
+    } else {
+        uint16_t p = nt_sched_period_ms(s);
+        // Hit on the first try: we may be trailing the frame, so aim 1 ms
+        // earlier next time. Hit after an empty poll: we are within 1 ms.
+        s->interval = (s->misses == 0 && p > 1) ? p - 1 : p;
+    }
+    s->misses = 0;
+}
+
+// The poll came back empty. `tracking` is true while a contact is still down
+// on the host (the frame is late, or this was a lift-off).
+static inline void nt_sched_empty(nt_sched_t *s, bool tracking) {
+    if (tracking) {
+        // The frame is imminent: retry shortly, then back off to half a
+        // period so a lift-off whose tip=0 frame was lost is still noticed.
+        s->misses++;
+        if (s->period == 0) {
+            s->interval = NT_SCHED_BASE_MS;
+        } else if (s->misses == 1) {
+            s->interval = 1;
+        } else {
+            uint16_t half = nt_sched_period_ms(s) / 2;
+            s->interval   = half > 1 ? half : 1;
+        }
+        return;
+    }
+
+    s->misses = 0;
+    if (s->idle_ms < UINT16_MAX - s->interval) {
+        s->idle_ms += s->interval;
+    }
+    if (s->idle_ms < NT_SCHED_IDLE_HOLD_MS) {
+        s->interval = NT_SCHED_BASE_MS;
+    } else if (s->idle_ms < NT_SCHED_IDLE_DEEP_AFTER_MS) {
+        s->interval = NT_SCHED_IDLE_MID_MS;
+    } else {
+        s->interval = NT_SCHED_IDLE_DEEP_MS;
+    }
+    // The next frame follows an idle gap: its scan_time delta is meaningless.
+    s->have_scan = false;
+}
@@ -0,0 +1,99 @@
+// Copyright 2026 ZSA Technology Labs, Inc <contact@zsa.io>
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// Pure, host-testable two-finger scroll for the mouse-fallback path.
+//
+// A host that never switches the pad to PTP sees only the fallback mouse, so
+// it has no gestures of its own: a second finger would otherwise do nothing.
+// nt_scroll_update() reads the same reconciled, smoothed contacts the PTP
+// report carries and, while exactly two are down, turns the motion of their
+// centroid into wheel (vertical) and pan (horizontal) counts.
+//
+// Output is in counts of a high-resolution wheel: counts_per_notch is the HID
+// resolution multiplier the host applies (120 with QMK's
+// POINTING_DEVICE_HIRES_SCROLL_ENABLE defaults), or 1 for a plain notched
+// wheel. Motion is carried exactly, as a remainder in units of
+// 1 / (2 * units_per_notch) counts, so slow scrolls are not lost to rounding
+// and a fast one past what a report can carry goes out over the following
+// frames. Changing the pair of contacts (a third finger replacing one, a lift
+// and a new touch) re-anchors instead of jumping.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "navigator_trackpad_contacts.h"
+
+typedef struct {
+    uint16_t counts_per_notch;  // wheel counts for one notch (the resolution multiplier)
+    uint16_t units_per_notch;   // centroid travel per notch, in logical units
+    int16_t  report_max;        // largest count one report carries
+    bool     natural;           // content follows the fingers (as PTP hosts default to)
+} nt_scroll_cfg_t;
+
+// Persisted across frames; all-zero is idle.
+typedef struct {
+    bool     active;  // a pair is down and anchored
+    uint8_t  pair;    // bitmap of the pair's host_ids
+    uint32_t sum_x;   // centroid of the pair last frame, times two
+    uint32_t sum_y;
+    int32_t  v_rem;   // motion not yet reported, in 1 / (2 * units_per_notch) counts
+    int32_t  h_rem;
+} nt_scroll_t;
+
+static inline int16_t nt_scroll_take(int32_t *rem, int32_t div, int16_t max) {
+    int32_t n = *rem / div;
+    if (n > max) n = max;
+    if (n < -max) n = -max;
+    *rem -= n * div;
+    return (int16_t)n;
+}
+
+// Advance by one frame's emitted contacts. Writes the wheel (v, positive up)
+// and pan (h, positive right) counts to report this frame, which may be
+// nonzero after the pair lifts while the remainder drains; returns whether
+// two contacts are down (the cursor should hold still).
+static inline bool nt_scroll_update(nt_scroll_t *s, const nt_emit_list_t *emit, const nt_scroll_cfg_t *cfg,
+                                    int16_t *v, int16_t *h) {
+    uint8_t  down = 0, pair = 0;
+    uint32_t sx = 0, sy = 0;
+    for (uint8_t i = 0; i < emit->count; i++) {
+        if (!emit->items[i].tip) continue;
+        down++;
+        pair |= 1u << emit->items[i].host_id;
+        sx += emit->items[i].x;
+        sy += emit->items[i].y;
+    }
+
+    if (down != 2) {
+        s->active = false;
+    } else if (!s->active || pair != s->pair) {
+        // A new pair: anchor on it, no motion this frame.
+        s->active = true;
+        s->pair   = pair;
+    } else {
+        // Contact y grows downwards. Natural: fingers down scroll the content
+        // down (wheel up), fingers right pan it right (pan left).
+        int32_t dx = (int32_t)sx - (int32_t)s->sum_x;
+        int32_t dy = (int32_t)sy - (int32_t)s->sum_y;
+        if (!cfg->natural) {
+            dx = -dx;
+            dy = -dy;
+        }
+        s->v_rem += dy * cfg->counts_per_notch;
+        s->h_rem -= dx * cfg->counts_per_notch;
+    }
+    s->sum_x = sx;
+    s->sum_y = sy;
+
+    int32_t div = 2 * (int32_t)cfg->units_per_notch;
+    *v          = nt_scroll_take(&s->v_rem, div, cfg->report_max);
+    *h          = nt_scroll_take(&s->h_rem, div, cfg->report_max);
+    return s->active;
+}
+
+// Whether whole counts are still waiting to be reported.
+static inline bool nt_scroll_pending(const nt_scroll_t *s, const nt_scroll_cfg_t *cfg) {
+    int32_t div = 2 * (int32_t)cfg->units_per_notch;
+    return s->v_rem <= -div || s->v_rem >= div || s->h_rem <= -div || s->h_rem >= div;
+}
@@ -0,0 +1,109 @@
+// Copyright 2026 ZSA Technology Labs, Inc <contact@zsa.io>
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// Fused sensor-to-logical transform for the Navigator trackpad.
+//
+// Every contact goes from raw sensor coordinates to the logical coordinates we
+// report through three stages: scale to 0..TRACKPAD_LOGICAL_MAX, subtract the
+// distortion field (navigator_trackpad_lut.h), and rotate about the configured
+// center (navigator_trackpad_rotation.h). Run one after another, each stage
+// truncates or rounds and clamps on its own, and an arbitrary angle costs
+// float trig on every point.
+//
+// nt_transform_point() does all three in one integer pass. The position stays
+// in Q16 through scaling and correction (the cell fraction is taken in Q10, so
+// the field is evaluated between whole units), is rotated with Q14 cos/sin,
+// and is rounded and clamped once at the end. The distortion table is passed
+// by pointer (the compiled one or a per-unit table loaded at init, NULL for
+// none); either way it is one direct cell lookup. The rotation is passed in as
+// Q14 constants so any angle, right angles included, takes the same path and
+// the compiler folds the multiplies by 0 and +/-1. nt_transform_staged() is
+// the stage-by-stage pipeline it replaces, kept as the reference for
+// tests/transform_test.c.
+//
+// Host-testable; depends only on the sensor constants and the LUT tables.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "navigator_trackpad_common.h"  // SENSOR_*, TRACKPAD_LOGICAL_MAX
+#include "navigator_trackpad_lut.h"
+#include "navigator_trackpad_rotation.h"
+
+// cos/sin in Q14 for a compile-time angle in degrees (clockwise).
+#define NT_TRANSFORM_Q14(v) ((int32_t)((v) * 16384.0f + ((v) < 0 ? -0.5f : 0.5f)))
+#define NT_TRANSFORM_COS_Q14(deg) NT_TRANSFORM_Q14(__builtin_cosf((deg) * 3.14159265358979f / 180.0f))
+#define NT_TRANSFORM_SIN_Q14(deg) NT_TRANSFORM_Q14(__builtin_sinf((deg) * 3.14159265358979f / 180.0f))
+
+// Field value at Q10 cell fractions (tx, ty in 0..1024), times 2^20.
+static inline int32_t nt_transform_field(const nt_lut_cell_t *c, int32_t tx, int32_t ty) {
+    return ((int32_t)c->e << 20) + (((int32_t)c->dx * tx + (int32_t)c->dy * ty) << 10) + (int32_t)c->dxy * tx * ty;
+}
+
+// Raw sensor point to corrected, rotated logical point, rounded once.
+static inline void nt_transform_point(uint16_t raw_x, uint16_t raw_y, int32_t cos_q14, int32_t sin_q14,
+                                      const nt_lut_t *lut, uint16_t *ox, uint16_t *oy) {
+    if (raw_x < SENSOR_X_MIN) raw_x = SENSOR_X_MIN;
+    if (raw_x > SENSOR_X_MAX) raw_x = SENSOR_X_MAX;
+    if (raw_y < SENSOR_Y_MIN) raw_y = SENSOR_Y_MIN;
+    if (raw_y > SENSOR_Y_MAX) raw_y = SENSOR_Y_MAX;
+    // Logical position, Q16.
+    int32_t lx = (int32_t)((uint32_t)(raw_x - SENSOR_X_MIN) * SENSOR_SCALE_X_MULT);
+    int32_t ly = (int32_t)((uint32_t)(raw_y - SENSOR_Y_MIN) * SENSOR_SCALE_Y_MULT);
+
+    if (lut) {
+        // 2^shift-unit cells: the cell index is bits (16 + shift).., the Q10
+        // fraction the 10 bits below it.
+        uint8_t fs = lut->shift + 6;
+        int32_t ix = lx >> (fs + 10), tx = (lx >> fs) & 0x3FF;
+        int32_t iy = ly >> (fs + 10), ty = (ly >> fs) & 0x3FF;
+        if (ix >= lut->cells) ix = lut->cells - 1, tx = 1024;
+        if (iy >= lut->cells) iy = lut->cells - 1, ty = 1024;
+        uint16_t c = ix * lut->cells + iy;
+        lx -= nt_transform_field(&lut->x[c], tx, ty) >> 4;
+        ly -= nt_transform_field(&lut->y[c], tx, ty) >> 4;
+    }
+
+    // Offset from the center in Q4 (rounded, so the bias does not flip sign
+    // with the angle), rotated into Q18.
+    int32_t dx = (lx - ((int32_t)NAVIGATOR_TRACKPAD_CENTER_X << 16) + (1 << 11)) >> 12;
+    int32_t dy = (ly - ((int32_t)NAVIGATOR_TRACKPAD_CENTER_Y << 16) + (1 << 11)) >> 12;
+    int32_t rx = ((int32_t)NAVIGATOR_TRACKPAD_CENTER_X << 18) + dx * cos_q14 - dy * sin_q14;
+    int32_t ry = ((int32_t)NAVIGATOR_TRACKPAD_CENTER_Y << 18) + dx * sin_q14 + dy * cos_q14;
+    rx = (rx + (1 << 17)) >> 18;
+    ry = (ry + (1 << 17)) >> 18;
+    if (rx < 0) rx = 0;
+    if (rx > TRACKPAD_LOGICAL_MAX) rx = TRACKPAD_LOGICAL_MAX;
+    if (ry < 0) ry = 0;
+    if (ry > TRACKPAD_LOGICAL_MAX) ry = TRACKPAD_LOGICAL_MAX;
+    *ox = (uint16_t)rx;
+    *oy = (uint16_t)ry;
+}
+
+// --- Staged reference ----------------------------------------------------------
+
+// Scale a sensor coordinate to the logical range (Q16 multiply, truncated).
+static inline uint16_t nt_scale_x(uint16_t raw) {
+    if (raw < SENSOR_X_MIN) raw = SENSOR_X_MIN;
+    if (raw > SENSOR_X_MAX) raw = SENSOR_X_MAX;
+    return ((uint32_t)(raw - SENSOR_X_MIN) * SENSOR_SCALE_X_MULT) >> 16;
+}
+
+static inline uint16_t nt_scale_y(uint16_t raw) {
+    if (raw < SENSOR_Y_MIN) raw = SENSOR_Y_MIN;
+    if (raw > SENSOR_Y_MAX) raw = SENSOR_Y_MAX;
+    return ((uint32_t)(raw - SENSOR_Y_MIN) * SENSOR_SCALE_Y_MULT) >> 16;
+}
+
+// Scale, then LUT, then float rotation, each rounding and clamping separately.
+static inline void nt_transform_staged(uint16_t raw_x, uint16_t raw_y, float cos_t, float sin_t, bool lut,
+                                       uint16_t *ox, uint16_t *oy) {
+    uint16_t px = nt_scale_x(raw_x);
+    uint16_t py = nt_scale_y(raw_y);
+    if (lut) {
+        nt_lut_correct_float(&px, &py);
+    }
+    nt_rotate_point(px, py, NAVIGATOR_TRACKPAD_CENTER_X, NAVIGATOR_TRACKPAD_CENTER_Y, cos_t, sin_t,
+                    TRACKPAD_LOGICAL_MAX, ox, oy);
+}
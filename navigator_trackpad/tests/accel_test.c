@@ -0,0 +1,160 @@
+// Copyright 2026 ZSA Technology Labs, Inc <contact@zsa.io>
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// Standalone host test for the compile-time mouse-fallback acceleration table.
+// Build & run from the module root:
+//   gcc -Wall -o /tmp/nt_accel_test navigator_trackpad/tests/accel_test.c -lm
+//   /tmp/nt_accel_test
+//
+// Compares each table against the powf() curve it replaces over the whole
+// input range, including the scaled lookups past the table, and a long stroke
+// accumulated through the table against the float accumulator, at the default
+// tuning, at the ends of the usual range and at the documented sensitivities
+// (1.0 normal, 2.0 faster).
+
+#include <assert.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../navigator_trackpad_accel.h"
+
+#define MAX_DELTA 250  // the stroke's largest step
+
+typedef struct {
+    float             sens, accel;
+    const nt_accel_t *table;
+} config_t;
+
+static const nt_accel_t table_default = NT_ACCEL_INIT(0.3f, 1.1f);
+static const nt_accel_t table_linear  = NT_ACCEL_INIT(1.0f, 1.0f);
+static const nt_accel_t table_slow    = NT_ACCEL_INIT(0.1f, 1.3f);
+static const nt_accel_t table_fast    = NT_ACCEL_INIT(0.5f, 1.2f);
+static const nt_accel_t table_normal  = NT_ACCEL_INIT(1.0f, 1.1f);
+static const nt_accel_t table_faster  = NT_ACCEL_INIT(2.0f, 1.1f);
+static const nt_accel_t table_steep   = NT_ACCEL_INIT(2.0f, 1.2f);
+
+static const config_t configs[] = {
+    {0.3f, 1.1f, &table_default},
+    {1.0f, 1.0f, &table_linear},
+    {0.1f, 1.3f, &table_slow},
+    {0.5f, 1.2f, &table_fast},
+    {1.0f, 1.1f, &table_normal},
+    {2.0f, 1.1f, &table_faster},
+    {2.0f, 1.2f, &table_steep},
+};
+
+// 1. Every entry within rounding (1/512 count) of the float curve, signs
+// mirrored and strictly rising, with no tuning anywhere near saturation.
+static void test_table_matches_powf(void) {
+    for (unsigned c = 0; c < sizeof(configs) / sizeof(configs[0]); c++) {
+        const config_t *k       = &configs[c];
+        double          max_err = 0;
+        assert(NT_ACCEL_FITS(k->sens, k->accel));
+        for (int d = 0; d < NT_ACCEL_TABLE_SIZE; d++) {
+            double want = k->sens * powf((float)d, k->accel);
+            double got  = nt_accel_q8(k->table, d) / 256.0;
+            double err  = fabs(got - want);
+            if (d > 0) assert(k->table->q8[d] > k->table->q8[d - 1]);
+            if (err > max_err) max_err = err;
+            assert(err <= 1.0 / 512 + 1e-4);
+            assert(nt_accel_q8(k->table, -d) == -nt_accel_q8(k->table, d));
+        }
+        printf("  sens %.1f accel %.1f: max error %.5f counts\n", k->sens, k->accel, max_err);
+    }
+    assert(table_default.q8[0] == 0);
+    assert(table_linear.q8[1] == 256 && table_linear.q8[MAX_DELTA] == MAX_DELTA * 256);
+    assert(table_faster.q8[NT_ACCEL_TABLE_SIZE - 1] > table_faster.q8[100] && "no plateau at 256 counts");
+}
+
+// 2. Past the table, deltas are scaled into it: within 0.1% of the curve up
+// to NT_ACCEL_MAX_DELTA, still monotonic, and exact for a linear curve.
+static void test_scaled_range(void) {
+    for (unsigned c = 0; c < sizeof(configs) / sizeof(configs[0]); c++) {
+        const config_t *k = &configs[c];
+        double  max_rel = 0;
+        int32_t prev    = nt_accel_q8(k->table, NT_ACCEL_TABLE_SIZE - 1);
+        for (int d = NT_ACCEL_TABLE_SIZE; d <= NT_ACCEL_MAX_DELTA; d++) {
+            int32_t q    = nt_accel_q8(k->table, d);
+            double  want = k->sens * pow(d, k->accel);
+            double  rel  = fabs(q / 256.0 - want) / want;
+            if (rel > max_rel) max_rel = rel;
+            assert(q >= prev && "the curve must not fold back");
+            assert(nt_accel_q8(k->table, -d) == -q);
+            prev = q;
+        }
+        printf("  sens %.1f accel %.1f: max error %.4f%% up to %d\n", k->sens, k->accel, max_rel * 100,
+               NT_ACCEL_MAX_DELTA);
+        assert(max_rel < 0.001);
+    }
+    for (int d = NT_ACCEL_TABLE_SIZE; d <= NT_ACCEL_MAX_DELTA; d++) {
+        assert(nt_accel_q8(&table_linear, d) == d * 256);
+    }
+}
+
+// 3. At the documented sensitivities the fallback's full delta range, table
+// and scaled lookups together, rises with every count of input and tracks the
+// curve: no fast flick lands on the same output as a slower one.
+static void test_documented_range(void) {
+    static const config_t documented[] = {
+        {1.0f, 1.1f, &table_normal},
+        {2.0f, 1.1f, &table_faster},
+        {2.0f, 1.2f, &table_steep},
+    };
+    for (unsigned c = 0; c < sizeof(documented) / sizeof(documented[0]); c++) {
+        const config_t *k    = &documented[c];
+        int32_t         prev = 0;
+        for (int d = 1; d <= NT_ACCEL_MAX_DELTA; d++) {
+            int32_t q    = nt_accel_q8(k->table, d);
+            double  want = k->sens * pow(d, k->accel);
+            assert(q > prev && "the curve must keep rising");
+            assert(fabs(q / 256.0 - want) <= want * 0.001 + 1.0 / 512);
+            prev = q;
+        }
+        printf("  sens %.1f accel %.1f: %d -> %.1f counts\n", k->sens, k->accel, NT_ACCEL_MAX_DELTA, prev / 256.0);
+    }
+    // The deltas that used to collapse onto one value at sensitivity 2.0.
+    assert(nt_accel_q8(&table_faster, 800) > nt_accel_q8(&table_faster, 500));
+    assert(fabs(nt_accel_q8(&table_faster, 800) / 256.0 - 2.0 * pow(800, 1.1)) < 2.0);
+}
+
+// 4. A stroke of every delta in turn, each way, reports the same distance
+// through the table as through the float accumulator it replaces, to within a
+// count.
+static void test_stroke_matches_float(void) {
+    for (unsigned c = 0; c < sizeof(configs) / sizeof(configs[0]); c++) {
+        const config_t *k = &configs[c];
+        float           facc = 0;
+        int32_t         qacc = 0;
+        long            fsum = 0, qsum = 0;
+        for (int pass = 0; pass < 2; pass++) {
+            for (int i = 0; i <= 2 * MAX_DELTA; i++) {
+                int16_t d = (int16_t)((i * 7) % (MAX_DELTA + 1)) * (pass ? -1 : 1);
+                if (d == 0) continue;
+                facc += (d < 0 ? -powf(-d, k->accel) : powf(d, k->accel)) * k->sens;
+                qacc += nt_accel_q8(k->table, d);
+                // Report whole counts, clamped like a mouse report, and carry the rest.
+                int32_t fd = (int32_t)facc, qd = qacc / 256;
+                if (fd > 127) fd = 127;
+                if (fd < -127) fd = -127;
+                if (qd > 127) qd = 127;
+                if (qd < -127) qd = -127;
+                facc -= fd;
+                qacc -= qd * 256;
+                fsum += labs(fd);
+                qsum += labs(qd);
+            }
+        }
+        printf("  sens %.1f accel %.1f: stroke %ld counts (float %ld)\n", k->sens, k->accel, qsum, fsum);
+        assert(labs(qsum - fsum) <= 1);
+    }
+}
+
+int main(void) {
+    test_table_matches_powf();
+    test_scaled_range();
+    test_documented_range();
+    test_stroke_matches_float();
+    printf("All acceleration tests passed\n");
+    return 0;
+}
@@ -0,0 +1,201 @@
+// Copyright 2026 ZSA Technology Labs, Inc <contact@zsa.io>
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// Host test for the Cirque Gen6 configuration-register shadow, run against the
+// mock bus with a minimal model of the sensor's register memory.
+// Build & run from the module root:
+//   gcc -Wall -Inavigator_trackpad/tests/host -o /tmp/nt_config_test navigator_trackpad/tests/config_test.c
+//   /tmp/nt_config_test
+//
+// Verifies that init reads and writes each config register once, produces the
+// same register values as the old per-setting read-modify-write sequence,
+// skips writes that would not change anything, and drops the shadow on a bus
+// failure. Also bounds the worst-case stall of a single staged-init step, both
+// with the sensor present and while it is unplugged, and checks that a sensor
+// which kept its configuration across a keyboard reset is up within a few
+// transactions.
+
+#include "../navigator_trackpad_common.c"
+#include "host/mock_bus.h"
+
+// --- Register model: just the three shadowed registers -------------------------
+static const uint32_t reg_addr[3] = {CGEN6_FEED_CONFIG4, CGEN6_XY_CONFIG, CGEN6_SYS_CONFIG1};
+static uint8_t        reg_val[3];
+static uint32_t       reg_reads[3], reg_writes[3];
+static uint32_t       report_reads;
+static int            pending_read = -1;
+static bool           corrupt_next_read;
+
+static int reg_index(const uint8_t *preamble) {
+    uint32_t addr = preamble[2] | (preamble[3] << 8) | ((uint32_t)preamble[4] << 16) | ((uint32_t)preamble[5] << 24);
+    for (int i = 0; i < 3; i++) {
+        if (reg_addr[i] == addr) return i;
+    }
+    return -1;
+}
+
+static i2c_status_t model_write(const uint8_t *data, uint16_t len) {
+    if (len < 8 || data[1] != 0x09) return I2C_STATUS_SUCCESS;
+    int r = reg_index(data);
+    if (data[0] == 0x01) {
+        pending_read = r;
+        if (r >= 0) reg_reads[r]++;
+    } else if (data[0] == 0x00 && r >= 0 && len >= 10) {
+        reg_val[r] = data[8];
+        reg_writes[r]++;
+    }
+    return I2C_STATUS_SUCCESS;
+}
+
+static i2c_status_t model_read(uint8_t *data, uint16_t len) {
+    memset(data, 0, len);
+    if (pending_read >= 0 && len == 4) {
+        data[0] = 4;
+        data[2] = reg_val[pending_read];
+        data[3] = (uint8_t)(data[0] + data[1] + data[2] + (corrupt_next_read ? 1 : 0));
+        corrupt_next_read = false;
+    } else if (pending_read < 0) {
+        report_reads++;
+    }
+    pending_read = -1;
+    return I2C_STATUS_SUCCESS;
+}
+
+static void setup(uint8_t feed4, uint8_t xy) {
+    mock_bus_reset();
+    mock_bus_set_device((mock_bus_device_t){.write = model_write, .read = model_read});
+    mock_clock_advance_ms(10);
+    cgen6_xfer_flush();
+    reg_val[0] = feed4;
+    reg_val[1] = xy;
+    reg_val[2] = 0;
+    memset(reg_reads, 0, sizeof reg_reads);
+    memset(reg_writes, 0, sizeof reg_writes);
+    report_reads = 0;
+}
+
+// 1. Cold init: one read and one write per register, same final values as the
+//    old sequence (FEED_CONFIG4 &= 0xF7 |= 0x04; XY_CONFIG |= swap|invx|invy|raw).
+static void test_init_batches(void) {
+    setup(0x0F, 0x00);
+    navigator_trackpad_device_init();
+    assert(trackpad_init);
+    assert(reg_val[0] == ((0x0F & 0xF7) | 0x04));
+    assert(reg_val[1] == 0x0F);
+    assert(reg_reads[0] == 1 && reg_writes[0] == 1);
+    assert(reg_reads[1] == 1 && reg_writes[1] == 1 && "XY_CONFIG must be read and written once");
+    printf("  cold init: FEED_CONFIG4 %u/%u, XY_CONFIG %u/%u reads/writes (was 1/1, 4/4), %llu us spun\n",
+           reg_reads[0], reg_writes[0], reg_reads[1], reg_writes[1], (unsigned long long)mock_bus_stats.spin_us);
+}
+
+// 2. Re-probe of an already-configured sensor writes nothing.
+static void test_reinit_skips_unchanged(void) {
+    setup(0x07, 0x0F);
+    navigator_trackpad_device_init();
+    assert(trackpad_init);
+    assert(reg_reads[0] == 1 && reg_reads[1] == 1);
+    assert(reg_writes[0] == 0 && reg_writes[1] == 0);
+}
+
+// 3. A warm shadow serves reads and write-through edits without re-reading;
+//    a bus failure drops it. Unshadowed registers bypass it.
+static void test_shadow_and_invalidation(void) {
+    setup(0x0F, 0x00);
+    navigator_trackpad_device_init();
+    uint32_t reads = reg_reads[1];
+
+    uint8_t v = 0;
+    assert(cirque_gen6_read_config(CGEN6_XY_CONFIG, &v) == CGEN6_SUCCESS && v == 0x0F);
+    assert(reg_reads[1] == reads && "warm shadow must not hit the bus");
+
+    assert(cirque_gen6_invert_x(false) == CGEN6_SUCCESS);  // outside a batch: written now
+    assert(reg_val[1] == 0x0E && reg_writes[1] == 2 && reg_reads[1] == reads);
+
+    mock_bus_inject_fault(I2C_STATUS_ERROR, 1);
+    assert(cgen6_xfer_start_report(CGEN6_MAX_PACKET_SIZE));
+    cgen6_xfer_flush();
+    assert(!trackpad_init);
+
+    assert(cirque_gen6_read_config(CGEN6_XY_CONFIG, &v) == CGEN6_SUCCESS && v == 0x0E);
+    assert(reg_reads[1] == reads + 1 && "bus failure must invalidate the shadow");
+
+    // A register outside the shadow is read straight from the sensor.
+    uint32_t xfers = mock_bus_stats.transactions;
+    cirque_gen6_read_config(CGEN6_HARDWARE_ID, &v);
+    assert(mock_bus_stats.transactions == xfers + 1);
+}
+
+// Drive the staged init the way the task does (one step per main-loop pass)
+// and return the longest time any single step held the CPU.
+static uint64_t run_staged_init(uint32_t *steps) {
+    uint64_t worst = 0;
+    *steps         = 0;
+    navigator_trackpad_init_start();
+    bool running = true;
+    while (running) {
+        uint64_t t0 = mock_clock_us;
+        running     = navigator_trackpad_init_step();
+        if (mock_clock_us - t0 > worst) worst = mock_clock_us - t0;
+        (*steps)++;
+        mock_clock_advance_us(100);
+    }
+    return worst;
+}
+
+// 4. No single step of the staged init blocks for more than one transfer.
+static void test_staged_init_stall(void) {
+    setup(0x0F, 0x00);
+    uint32_t steps;
+    uint64_t start = mock_clock_us;
+    uint64_t worst = run_staged_init(&steps);
+    printf("  staged init: %u steps over %llu ms, worst single step %llu us, %llu us spun\n",
+           steps, (unsigned long long)((mock_clock_us - start) / 1000), (unsigned long long)worst,
+           (unsigned long long)mock_bus_stats.spin_us);
+    assert(trackpad_init);
+    assert(reg_val[0] == 0x07 && reg_val[1] == 0x0F);
+    assert(mock_bus_stats.spin_us == 0 && "staged init must never busy-wait");
+    assert(worst < 500 && "a staged init step must not stall for more than a few hundred us");
+
+    // Unplugged: the probe is a single ping and gives up immediately.
+    setup(0x0F, 0x00);
+    mock_bus_present = false;
+    worst            = run_staged_init(&steps);
+    printf("  absent probe: %u step(s), worst %llu us\n", steps, (unsigned long long)worst);
+    assert(!trackpad_init && steps == 1 && worst < 100);
+}
+
+// 5. Warm boot: the sensor is still configured, so init is the ping plus the
+//    two fingerprint reads. A garbled fingerprint falls back to the full path.
+static void test_warm_boot(void) {
+    uint32_t steps;
+    setup(0x07, 0x0F);
+    uint64_t start = mock_clock_us;
+    run_staged_init(&steps);
+    uint64_t warm_us = mock_clock_us - start;
+    assert(trackpad_init);
+    assert(report_reads == 0 && reg_writes[0] == 0 && reg_writes[1] == 0 && "warm boot must skip drain and writes");
+
+    setup(0x0F, 0x00);
+    start = mock_clock_us;
+    run_staged_init(&steps);
+    uint64_t cold_us = mock_clock_us - start;
+    printf("  time to first report: warm %llu us, cold %llu us\n", (unsigned long long)warm_us,
+           (unsigned long long)cold_us);
+    assert(warm_us < 5000 && cold_us > 50000);
+
+    setup(0x07, 0x0F);
+    corrupt_next_read = true;
+    run_staged_init(&steps);
+    assert(trackpad_init && report_reads > 0 && "bad fingerprint must fall back to the drain");
+    assert(reg_val[0] == 0x07 && reg_val[1] == 0x0F);
+}
+
+int main(void) {
+    test_init_batches();
+    test_reinit_skips_unchanged();
+    test_shadow_and_invalidation();
+    test_staged_init_stall();
+    test_warm_boot();
+    printf("All config tests passed\n");
+    return 0;
+}
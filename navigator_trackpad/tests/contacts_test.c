@@ -5,11 +5,13 @@
 // Build & run from the module root:
 //   gcc -Wall -o /tmp/nt_contacts_test navigator_trackpad/tests/contacts_test.c
 //   /tmp/nt_contacts_test
+// and again for a five-finger part with -DNT_MAX_CONTACTS=5.
 //
 // Models the host (libinput / Windows PTP) side: the host believes a contact
 // is down until it is explicitly reported with tip=0. We feed sensor frames
 // through nt_reconcile_contacts, apply the emitted report to a simulated host,
-// and assert the host is never left with a stuck contact.
+// and assert the host is never left with a stuck contact. The tests are
+// written against NT_MAX_CONTACTS, so they hold from two slots up.
 
 #include <assert.h>
 #include <stdbool.h>
@@ -132,11 +134,106 @@ static void test_no_host_id_alias(void) {
     assert(host_count() == 0);
 }
 
+// Every slot filled, then the fingers lift one by one from the middle out:
+// the others keep their host ids throughout.
+static void test_all_slots(void) {
+    nt_contact_state_t  st = {0};
+    nt_emit_list_t      e;
+    nt_sensor_contact_t f[NT_MAX_CONTACTS];
+    uint8_t             host_of[NT_MAX_CONTACTS];
+    host_reset();
+
+    for (uint8_t i = 0; i < NT_MAX_CONTACTS; i++) f[i] = (nt_sensor_contact_t){(uint8_t)(60 - i * 7), i * 100, 500, true};
+    nt_reconcile_contacts(&st, f, NT_MAX_CONTACTS, &e);
+    host_apply(&e);
+    assert(host_count() == NT_MAX_CONTACTS && e.count == NT_MAX_CONTACTS);
+    for (uint8_t i = 0; i < NT_MAX_CONTACTS; i++) host_of[i] = e.items[i].host_id;
+
+    for (uint8_t n = NT_MAX_CONTACTS; n > 0; n--) {
+        uint8_t gone = n / 2;
+        memmove(&f[gone], &f[gone + 1], (n - gone - 1) * sizeof(f[0]));
+        memmove(&host_of[gone], &host_of[gone + 1], n - gone - 1);
+        nt_reconcile_contacts(&st, f, n - 1, &e);
+        host_apply(&e);
+        assert(host_count() == n - 1 && st.count == n - 1);
+        for (uint8_t i = 0; i < e.count; i++) {
+            if (!e.items[i].tip) continue;
+            bool found = false;
+            for (uint8_t k = 0; k < n - 1; k++) found |= host_of[k] == e.items[i].host_id && f[k].x == e.items[i].x;
+            assert(found && "a continuing contact changed host id");
+        }
+    }
+    assert(st.host_used == 0);
+}
+
+// One finger replaced by another in a single frame: the release and the new
+// contact must not share a host id within the report.
+static void test_swap_in_one_frame(void) {
+    nt_contact_state_t st = {0};
+    nt_emit_list_t     e;
+    host_reset();
+
+    nt_sensor_contact_t f1[] = {{12, 100, 100, true}};
+    nt_sensor_contact_t f2[] = {{13, 800, 800, true}};
+    nt_reconcile_contacts(&st, f1, 1, &e);
+    host_apply(&e);
+    nt_reconcile_contacts(&st, f2, 1, &e);
+    assert(e.count == 2 && !e.items[0].tip && e.items[1].tip);
+    host_apply(&e);  // asserts distinct host ids
+    assert(host_count() == 1);
+
+    nt_reconcile_contacts(&st, NULL, 0, &e);
+    host_apply(&e);
+    nt_reconcile_contacts(&st, NULL, 0, &e);
+    host_apply(&e);
+    assert(host_count() == 0);
+}
+
+// Random frames of up to NT_MAX_CONTACTS + 1 fingers over the whole sensor id
+// range: the host's down set always matches the tracked set, stays within the
+// slot count, and nothing is stuck after the final lift.
+static void test_random_frames(void) {
+    nt_contact_state_t st = {0};
+    nt_emit_list_t     e;
+    uint32_t           rng = 12345;
+    host_reset();
+
+    for (int frame = 0; frame < 200000; frame++) {
+        nt_sensor_contact_t f[NT_MAX_CONTACTS + 1];
+        uint64_t            used = 0;
+        rng                      = rng * 1103515245u + 12345u;
+        uint8_t n                = (rng >> 16) % (NT_MAX_CONTACTS + 2);
+        for (uint8_t i = 0; i < n; i++) {
+            uint8_t id;
+            do {
+                rng = rng * 1103515245u + 12345u;
+                id  = (rng >> 16) % (frame & 1 ? 16 : NT_SENSOR_IDS);  // odd frames reuse a few ids
+            } while (used & ((uint64_t)1 << id));
+            used |= (uint64_t)1 << id;
+            f[i] = (nt_sensor_contact_t){id, (uint16_t)(rng >> 20), (uint16_t)frame, true};
+        }
+        nt_reconcile_contacts(&st, f, n, &e);
+        host_apply(&e);
+        assert(host_count() == st.count && st.count <= NT_MAX_CONTACTS);
+        for (uint8_t i = 0; i < st.count; i++) {
+            assert(host_down[st.items[i].host_id]);
+            assert(st.slot[st.items[i].sensor_id] == i + 1);
+        }
+    }
+    nt_reconcile_contacts(&st, NULL, 0, &e);
+    host_apply(&e);
+    assert(host_count() == 0 && st.host_used == 0);
+    for (int id = 0; id < NT_SENSOR_IDS; id++) assert(st.slot[id] == 0);
+}
+
 int main(void) {
     test_single_finger();
     test_two_finger_clean();
     test_no_host_id_alias();
     test_three_finger_swirl_no_stuck();
+    test_all_slots();
+    test_swap_in_one_frame();
+    test_random_frames();
     printf("All contact tests passed\n");
     return 0;
 }
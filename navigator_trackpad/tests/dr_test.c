@@ -0,0 +1,231 @@
+// Copyright 2026 ZSA Technology Labs, Inc <contact@zsa.io>
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// Host test for data-ready (DR) driven sampling in the PTP task, run against
+// the mock bus and a simulated clock that raises the DR line whenever the
+// modelled sensor produces a frame.
+// Build & run from the module root:
+//   gcc -Wall -Inavigator_trackpad/tests/host -o /tmp/nt_dr_test navigator_trackpad/tests/dr_test.c -lm
+//   /tmp/nt_dr_test
+//
+// Verifies that in DR mode the task reads exactly once per sensor frame (no
+// empty polls), reports each frame within a main-loop iteration or two of the
+// DR edge, touches the bus only for a slow liveness probe while idle, still
+// releases a contact whose lift-off packet was lost, and notices a sensor
+// unplugged and power-cycled while idle.
+
+#define NAVIGATOR_TRACKPAD_DR_PIN 3
+
+#include "../navigator_trackpad_common.c"
+#include "../navigator_trackpad_pipeline.c"
+#include "../navigator_trackpad_ptp.c"
+#include "host/mock_bus.h"
+#include "host/cgen6_sim.h"
+
+#define LOOP_US 100       // main-loop period of the simulated keyboard
+#define FRAME_US 8000     // sensor frame period (~125 Hz)
+
+// --- Host side: capture what the task sends -----------------------------------
+static uint32_t ptp_sends;
+static bool     host_tip;        // tip bit of finger 0 in the last report
+static uint64_t last_send_us;
+
+void send_digitizer_touchpad(report_digitizer_touchpad_t *report) {
+    ptp_sends++;
+    host_tip     = report->fingers[0].confidence_tip & 0x02;
+    last_send_us = mock_clock_us;
+}
+
+void send_digitizer_touchpad_mouse(report_digitizer_touchpad_mouse_t *report) {
+    (void)report;
+}
+
+uint8_t digitizer_touchpad_get_input_mode(void) {
+    return TRACKPAD_INPUT_MODE_PTP;
+}
+
+// --- Sensor model: one queued frame at a time, DR asserted while pending -------
+// Register reads (the idle probe) answer FEED_CONFIG4 as configured for PTP.
+static uint8_t  frame[CGEN6_MAX_PACKET_SIZE];
+static bool     frame_pending;
+static bool     reg_read_pending;
+static uint32_t frames_made, frames_read, empty_reads, reg_reads;
+
+static void dr_set(bool asserted) {
+    mock_gpio_level[NAVIGATOR_TRACKPAD_DR_PIN] = !asserted;  // active low
+}
+
+static void sensor_emit(uint16_t x, uint16_t y, bool tip, uint16_t scan_time) {
+    memset(frame, 0, sizeof frame);
+    frame[0]  = CGEN6_MAX_PACKET_SIZE;
+    frame[2]  = CGEN6_PTP_REPORT_ID;
+    frame[3]  = (uint8_t)((5 << 2) | (tip ? 0x03 : 0x01));
+    frame[4]  = x & 0xFF;
+    frame[5]  = x >> 8;
+    frame[6]  = y & 0xFF;
+    frame[7]  = y >> 8;
+    frame[13] = scan_time & 0xFF;
+    frame[14] = scan_time >> 8;
+    frame[15] = tip ? 1 : 0;
+    frame_pending = true;
+    frames_made++;
+    dr_set(true);
+}
+
+static i2c_status_t sensor_read(uint8_t *data, uint16_t len) {
+    memset(data, 0, len);
+    if (reg_read_pending) {
+        static const uint8_t feed4[] = {4, 0, 0x07, 4 + 0x07};  // [len, value, cksum]
+        reg_read_pending             = false;
+        memcpy(data, feed4, len < sizeof feed4 ? len : sizeof feed4);
+        reg_reads++;
+        return I2C_STATUS_SUCCESS;
+    }
+    if (frame_pending) {
+        memcpy(data, frame, len < sizeof frame ? len : sizeof frame);
+        frame_pending = false;
+        frames_read++;
+    } else {
+        empty_reads++;
+    }
+    dr_set(false);
+    return I2C_STATUS_SUCCESS;
+}
+
+static i2c_status_t sensor_write(const uint8_t *data, uint16_t len) {
+    reg_read_pending = len == 8 && data[0] == 0x01;
+    return I2C_STATUS_SUCCESS;
+}
+
+static void setup(void) {
+    mock_bus_reset();
+    mock_bus_set_device((mock_bus_device_t){.write = sensor_write, .read = sensor_read});
+    mock_clock_advance_ms(100);
+    cgen6_xfer_flush();
+    trackpad_init = true;
+    dr_set(false);
+    frame_pending = reg_read_pending = false;
+    frames_made = frames_read = empty_reads = reg_reads = ptp_sends = 0;
+}
+
+// Run the task for `us` microseconds of simulated time. While `touching`, the
+// sensor emits a frame every FRAME_US; `lift_frame` emits one tip=0 frame first.
+static uint64_t max_latency_us;
+static void run(uint64_t us, bool touching, bool lift_frame) {
+    static uint16_t scan = 0;
+    uint64_t        end  = mock_clock_us + us;
+    uint64_t        next = mock_clock_us;
+    uint64_t        edge = 0;
+    if (lift_frame) {
+        sensor_emit(1000, 1000, false, scan += 80);
+        edge = mock_clock_us;
+    }
+    while (mock_clock_us < end) {
+        if (touching && mock_clock_us >= next) {
+            sensor_emit(1000 + (uint16_t)(frames_made * 7), 1000, true, scan += 80);
+            edge = mock_clock_us;
+            next += FRAME_US;
+        }
+        uint32_t sends = ptp_sends;
+        navigator_trackpad_ptp_task();
+        if (ptp_sends != sends && edge) {
+            uint64_t lat = last_send_us - edge;
+            if (lat > max_latency_us) max_latency_us = lat;
+            edge = 0;
+        }
+        mock_clock_advance_us(LOOP_US);
+    }
+}
+
+// 1. A 200 ms stroke: one read per frame, no empty reads, low DR-to-report latency.
+static void test_one_read_per_frame(void) {
+    setup();
+    max_latency_us = 0;
+    run(200000, true, false);
+    printf("  stroke: %u frames, %u reads, %u empty, %u reports, max DR->report %llu us\n",
+           frames_made, frames_read, empty_reads, ptp_sends, (unsigned long long)max_latency_us);
+    assert(frames_read == frames_made && "every frame must be read");
+    assert(empty_reads == 0 && "DR mode must never read an empty frame");
+    assert(ptp_sends == frames_made);
+    assert(host_tip);
+    assert(max_latency_us <= 3 * LOOP_US + 1000 && "report must follow the DR edge promptly");
+
+    // Lift with a proper tip=0 frame: released straight away.
+    run(20000, false, true);
+    assert(!host_tip);
+}
+
+// 2. An idle pad reads no reports; its only bus traffic is the liveness probe,
+// once per probe interval.
+static void test_idle_is_quiet(void) {
+    setup();
+    run(3000000, false, false);
+    printf("  idle 3 s: %u transactions, %u probes (polling would issue ~%d)\n", mock_bus_stats.transactions,
+           reg_reads, 3000 / NAVIGATOR_TRACKPAD_POLL_INTERVAL_MS);
+    assert(frames_read == 0 && empty_reads == 0);
+    assert(mock_bus_stats.transactions == reg_reads);
+    assert(reg_reads <= 3000 / NAVIGATOR_TRACKPAD_PROBE_INTERVAL_MS + 1);
+    assert(trackpad_init && "a good probe must leave the sensor in service");
+}
+
+// 3. The lift-off frame is lost: the contact is released after the DR timeout.
+static void test_lost_liftoff_released(void) {
+    setup();
+    run(50000, true, false);
+    assert(host_tip);
+    uint64_t lift = mock_clock_us;
+    run(100000, false, false);
+    assert(!host_tip && "stranded contact must be released");
+    uint64_t after = last_send_us - lift;
+    printf("  lost lift-off: released after %llu ms\n", (unsigned long long)(after / 1000));
+    assert(after <= (NAVIGATOR_TRACKPAD_DR_LIFTOFF_TIMEOUT_MS + FRAME_US / 1000 + 2) * 1000);
+}
+
+// 4. Unplug, power-cycle and replug while idle, against the simulated sensor.
+// DR never fires on an idle pad, so only the probe can notice; the sensor must
+// be back in PTP mode before the next stroke.
+static const cgen6_sim_key_t swipe[] = {
+    {.t_ms = 0, .count = 1, .fingers = {{.id = 1, .x = 600, .y = 1100}}},
+    {.t_ms = 300, .count = 1, .fingers = {{.id = 1, .x = 1600, .y = 1100}}},
+    {.t_ms = 300, .count = 0},
+};
+
+static void sim_run(uint64_t us) {
+    uint64_t end = mock_clock_us + us;
+    while (mock_clock_us < end) {
+        cgen6_sim_update();
+        navigator_trackpad_ptp_task();
+        mock_clock_advance_us(LOOP_US);
+    }
+}
+
+static void test_replug_while_idle(void) {
+    cgen6_sim_reset();
+    mock_clock_advance_ms(100);
+    navigator_trackpad_device_init();
+    assert(trackpad_init);
+    sim_run(100000);
+
+    mock_bus_present = false;
+    sim_run(50000);
+    cgen6_sim_power_cycle();
+    mock_bus_present = true;
+    sim_run(NAVIGATOR_TRACKPAD_PROBE_INTERVAL_MS * 1000 + 100000);
+
+    ptp_sends = 0;
+    cgen6_sim_play(swipe, 3);
+    sim_run(400000);
+    printf("  replug while idle: %u frames, %u reports\n", cgen6_sim.stats.frames, ptp_sends);
+    assert(trackpad_init);
+    assert((cgen6_sim_peek(CGEN6_FEED_CONFIG4) & 0x0C) == 0x04 && "PTP mode must be restored");
+    assert(ptp_sends > 0 && !host_tip);
+}
+
+int main(void) {
+    test_one_read_per_frame();
+    test_idle_is_quiet();
+    test_lost_liftoff_released();
+    test_replug_while_idle();
+    printf("All DR tests passed\n");
+    return 0;
+}
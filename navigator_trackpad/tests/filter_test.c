@@ -9,14 +9,21 @@
 // Verifies the two properties the PTP path relies on:
 //   1. Jitter on a near-still signal is strongly attenuated.
 //   2. A fast ramp is followed with little lag (no floaty trailing).
-// plus the basics (seed-on-first-sample, reset).
+// plus the basics (seed-on-first-sample, reset), and that clocking dt from the
+// sensor's scan_time beats the jittery millisecond timer on a real poll
+// pattern (wraparound and stall fallback included). The fixed-point variant
+// must stay within one logical unit of the float filter on every sample; the
+// cost of both per sample is printed for comparison. The noise-floor estimate
+// must find synthetic noise levels per axis and adapt mincutoff sensibly.
 
 #include <assert.h>
 #include <math.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
 #include "../navigator_trackpad_filter.h"
 
-// Matches the defaults in navigator_trackpad_ptp.c.
+// Matches the defaults in navigator_trackpad_pipeline.h.
 #define MINCUTOFF 1.5f
 #define BETA 0.0070f
 #define DCUTOFF 15.0f
@@ -87,10 +94,279 @@ static void test_seed_and_reset(void) {
     assert(x == 1500.0f && y == 200.0f && "reset then first sample must seed exactly");
 }
 
+// 4. dt from scan_time: exact deltas across the 16-bit wrap, MCU fallback on a
+//    stall or an implausible jump, clamped either way.
+static void test_frame_dt(void) {
+    nt_frame_clock_t c = {.scan = 65500, .ms = 1000};
+    assert(fabsf(nt_frame_dt(&c, 44, 1008) - 0.0080f) < 1e-6f && "wraparound must give the true delta");
+    assert(fabsf(nt_frame_dt(&c, 44, 1017) - 0.0090f) < 1e-6f && "stalled scan_time falls back to the timer");
+    assert(fabsf(nt_frame_dt(&c, 30000, 1025) - 0.0080f) < 1e-6f && "a jump falls back to the timer");
+    assert(nt_frame_dt(&c, 30000, 1025) == NT_DT_MIN);
+    assert(nt_frame_dt(&c, 30000, 5000) == NT_DT_MAX);
+}
+
+// 5. A constant-speed stroke sampled every 8 ms by the sensor, but read by a
+//    5 ms poll with a 1 ms timer: compare the filter clocked from the timer
+//    against the filter clocked from scan_time. With exact dt the lag behind
+//    the live position is steady; timer dt makes it wobble (visible as uneven
+//    cursor motion on a smooth stroke).
+static void test_jittered_clock(void) {
+    const float speed = 10.0f;  // units per ms, ~2x a brisk stroke
+    nt_euro_axis_t   ft = {0}, fs = {0};
+    nt_frame_clock_t clk = {0};
+    uint32_t         prev_ms = 0;
+    float            lags[2][300];
+    int              n = 0;
+
+    for (int k = 0; k < 300; k++) {
+        uint32_t made_us = 2000 + k * 8000;                              // sensor sample time
+        uint32_t read_us = made_us + ((made_us / 1000 * 7) % 5) * 1000 + 300;  // poll phase
+        uint32_t ms      = read_us / 1000;
+        uint16_t scan    = (uint16_t)(made_us / 100);
+        float    x       = speed * made_us / 1000.0f;
+
+        float dt_timer = k ? (float)(ms - prev_ms) / 1000.0f : DT;
+        if (dt_timer < NT_DT_MIN) dt_timer = NT_DT_MIN;
+        float dt_scan = nt_frame_dt(&clk, scan, ms);
+        if (k == 0) dt_scan = DT;
+        prev_ms = ms;
+
+        float lag[2];
+        lag[0] = x - nt_euro_axis_filter(&ft, x, dt_timer, MINCUTOFF, BETA, DCUTOFF);
+        lag[1] = x - nt_euro_axis_filter(&fs, x, dt_scan, MINCUTOFF, BETA, DCUTOFF);
+        if (k >= 20) {
+            lags[0][n]   = lag[0];
+            lags[1][n++] = lag[1];
+        }
+    }
+    double mean[2] = {0}, sd[2] = {0};
+    for (int i = 0; i < 2; i++) {
+        for (int j = 0; j < n; j++) mean[i] += lags[i][j] / n;
+        for (int j = 0; j < n; j++) sd[i] += (lags[i][j] - mean[i]) * (lags[i][j] - mean[i]) / n;
+        sd[i] = sqrt(sd[i]);
+    }
+    printf("  jittered clock: lag mean/sd timer %.1f/%.2f units, scan_time %.1f/%.2f units\n", mean[0], sd[0],
+           mean[1], sd[1]);
+    assert(sd[1] < 0.5 && "scan_time-clocked lag must be steady");
+    assert(sd[1] * 10 < sd[0]);
+    assert(mean[1] <= mean[0] + 1.0);
+}
+
+// Float and fixed-point filters side by side on one stroke; returns the largest
+// difference between the rounded outputs.
+static int32_t fixed_vs_float(const int32_t *xs, const int32_t *ys, const uint16_t *ticks, int n) {
+    nt_euro_point_t       ff = {0};
+    nt_euro_point_fixed_t fq = {0};
+    int32_t               worst = 0;
+    for (int i = 0; i < n; i++) {
+        float fx = (float)xs[i], fy = (float)ys[i];
+        nt_euro_point_filter(&ff, &fx, &fy, ticks[i] * 0.0001f, MINCUTOFF, BETA, DCUTOFF);
+
+        nt_euro_fixed_dt_t dt;
+        nt_euro_fixed_dt(&dt, ticks[i], NT_EURO_HZ_Q8(DCUTOFF));
+        int32_t qx = xs[i], qy = ys[i];
+        nt_euro_point_filter_fixed(&fq, &qx, &qy, &dt, NT_EURO_HZ_Q8(MINCUTOFF), NT_EURO_BETA_Q20(BETA));
+
+        int32_t dx = abs(qx - (int32_t)floorf(fx + 0.5f)), dy = abs(qy - (int32_t)floorf(fy + 0.5f));
+        if (dx > worst) worst = dx;
+        if (dy > worst) worst = dy;
+    }
+    return worst;
+}
+
+// 6. Fixed point matches float to one logical unit: jitter at rest, a fast
+//    ramp, slow circles, and random strokes with uneven frame spacing.
+#define EQ_N 2000
+static int32_t  eq_x[EQ_N], eq_y[EQ_N];
+static uint16_t eq_ticks[EQ_N];
+
+static void test_fixed_matches_float(void) {
+    int32_t worst[4];
+    for (int i = 0; i < EQ_N; i++) {
+        eq_x[i]     = 1000 + (int32_t)floorf(pseudo_noise(i, 8.0f) + 0.5f);
+        eq_y[i]     = 1000 + (int32_t)floorf(pseudo_noise(i + 777, 8.0f) + 0.5f);
+        eq_ticks[i] = 80;
+    }
+    worst[0] = fixed_vs_float(eq_x, eq_y, eq_ticks, EQ_N);
+
+    for (int i = 0; i < 13; i++) {
+        eq_x[i] = 100 + 150 * i;
+        eq_y[i] = 2000 - 150 * i;
+    }
+    worst[1] = fixed_vs_float(eq_x, eq_y, eq_ticks, 13);
+
+    for (int i = 0; i < EQ_N; i++) {
+        eq_x[i] = 1024 + (int32_t)(600.0f * cosf(i * 0.01f) + pseudo_noise(i, 3.0f));
+        eq_y[i] = 1024 + (int32_t)(600.0f * sinf(i * 0.01f) + pseudo_noise(i + 99, 3.0f));
+    }
+    worst[2] = fixed_vs_float(eq_x, eq_y, eq_ticks, EQ_N);
+
+    // Random walk with bursts of speed, frames 1..20 ms apart.
+    int32_t x = 1024, y = 1024, vx = 0, vy = 0;
+    for (int i = 0; i < EQ_N; i++) {
+        if (i % 50 == 0) {
+            vx = (int32_t)pseudo_noise(i, 60.0f);
+            vy = (int32_t)pseudo_noise(i + 5, 60.0f);
+        }
+        x += vx + (int32_t)pseudo_noise(i + 11, 4.0f);
+        y += vy + (int32_t)pseudo_noise(i + 13, 4.0f);
+        if (x < 0 || x > 2047) vx = -vx, x = x < 0 ? 0 : 2047;
+        if (y < 0 || y > 2047) vy = -vy, y = y < 0 ? 0 : 2047;
+        eq_x[i]     = x;
+        eq_y[i]     = y;
+        eq_ticks[i] = (uint16_t)(110 + pseudo_noise(i + 17, 100.0f));
+    }
+    worst[3] = fixed_vs_float(eq_x, eq_y, eq_ticks, EQ_N);
+
+    printf("  fixed vs float: max |diff| jitter %d, ramp %d, circles %d, random strokes %d units\n", worst[0],
+           worst[1], worst[2], worst[3]);
+    for (int i = 0; i < 4; i++) assert(worst[i] <= 1 && "fixed point must match float to one logical unit");
+}
+
+// 7. Per-sample cost, for reference. The host has an FPU, so the two come out
+//    close here; on an FPU-less MCU every float operation in the float path is
+//    a soft-float library call while the fixed path stays a few dozen integer
+//    instructions per axis.
+static double ns_per_point(bool fixed) {
+    nt_euro_point_t       ff = {0};
+    nt_euro_point_fixed_t fq = {0};
+    volatile int32_t      sink = 0;
+    struct timespec       t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (int r = 0; r < 200; r++) {
+        for (int i = 0; i < EQ_N; i++) {
+            if (fixed) {
+                nt_euro_fixed_dt_t dt;
+                nt_euro_fixed_dt(&dt, eq_ticks[i], NT_EURO_HZ_Q8(DCUTOFF));
+                int32_t qx = eq_x[i], qy = eq_y[i];
+                nt_euro_point_filter_fixed(&fq, &qx, &qy, &dt, NT_EURO_HZ_Q8(MINCUTOFF), NT_EURO_BETA_Q20(BETA));
+                sink += qx + qy;
+            } else {
+                float fx = (float)eq_x[i], fy = (float)eq_y[i];
+                nt_euro_point_filter(&ff, &fx, &fy, eq_ticks[i] * 0.0001f, MINCUTOFF, BETA, DCUTOFF);
+                sink += (int32_t)(fx + 0.5f) + (int32_t)(fy + 0.5f);
+            }
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    (void)sink;
+    return ((t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec)) / (200.0 * EQ_N);
+}
+
+static void test_fixed_cost(void) {
+    double f = ns_per_point(false), q = ns_per_point(true);
+    printf("  cost per point (host): float %.1f ns, fixed %.1f ns; alpha tables %u bytes\n", f, q,
+           (unsigned)(sizeof(nt_euro_alpha_fine) + sizeof(nt_euro_alpha_coarse)));
+}
+
+// Noise-floor estimate, with the reference at the +/-8 unit trace the defaults
+// were tuned on (uniform noise: sigma^2 = 8^2 / 3).
+#define NOISE_REF_VAR (64.0f / 3.0f)
+static const nt_noise_cfg_t noise_cfg = {NT_EURO_HZ_Q8(MINCUTOFF), NT_NOISE_VAR_Q4(NOISE_REF_VAR),
+                                         NT_EURO_HZ_Q8(0.5f), NT_EURO_HZ_Q8(4.0f)};
+
+// Touches on a pad with +/-ax, +/-ay units of jitter: each rests for a while
+// (after a short touch-down slide) and then strokes away fast.
+static void noise_session(nt_noise_t *n, float ax, float ay, int touches) {
+    int k = 0;
+    for (int t = 0; t < touches; t++) {
+        nt_noise_contact_t c = {0};
+        float              x0 = 300 + 50 * t, y0 = 1500 - 40 * t;
+        for (int i = 0; i < 150; i++, k++) {
+            float x = x0, y = y0;
+            if (i < 10) x += 12 * i, y -= 5 * i;                        // touch-down slide
+            else if (i < 110) x += 120, y -= 50;                         // rest
+            else x += 120 + 45 * (i - 110), y -= 50 - 30 * (i - 110);  // stroke
+            nt_noise_update(n, &c, (int32_t)floorf(x + pseudo_noise(k, ax) + 0.5f),
+                            (int32_t)floorf(y + pseudo_noise(k + 7777, ay) + 0.5f), &noise_cfg);
+        }
+    }
+}
+
+// Mean |dev| of a resting finger (one axis) through the float filter.
+static float rest_jitter(float amp, float mincutoff) {
+    nt_euro_axis_t f = {0};
+    float          dev = 0;
+    for (int i = 0; i < 400; i++) {
+        float x = 1000.0f + (float)floorf(pseudo_noise(i + 4242, amp) + 0.5f);
+        float fx = nt_euro_axis_filter(&f, x, DT, mincutoff, BETA, DCUTOFF);
+        if (i >= 50) dev += fabsf(fx - 1000.0f) / 350;
+    }
+    return dev;
+}
+
+// Lag of a slow stroke (2 units/frame, 250 units/s) through the float filter.
+static float slow_lag(float mincutoff) {
+    nt_euro_axis_t f = {0};
+    float          lag = 0;
+    for (int i = 0; i < 100; i++) {
+        float x = 200.0f + 2.0f * i;
+        float fx = nt_euro_axis_filter(&f, x, DT, mincutoff, BETA, DCUTOFF);
+        if (i >= 50) lag += (x - fx) / 50;
+    }
+    return lag;
+}
+
+// 8. The estimate finds the per-axis noise floor from stationary stretches,
+//    ignores the strokes in between, and moves mincutoff so that quiet and
+//    noisy pads end up with similar residual jitter (and a quiet pad with less
+//    lag), within the bounds.
+static void test_noise_estimate(void) {
+    const float amps[3] = {2.0f, 8.0f, 16.0f};
+    float       cut[3], jit_nominal[3], jit_adapted[3];
+    for (int l = 0; l < 3; l++) {
+        nt_noise_t n = NT_NOISE_INIT(NT_EURO_HZ_Q8(MINCUTOFF), NT_NOISE_VAR_Q4(NOISE_REF_VAR));
+        noise_session(&n, amps[l], amps[l], 20);
+        // True variance of the (rounded) noise actually fed in.
+        double sum = 0, sum2 = 0;
+        for (int k = 0; k < 3000; k++) {
+            double v = floorf(pseudo_noise(k, amps[l]) + 0.5f);
+            sum += v, sum2 += v * v;
+        }
+        float want = (float)(sum2 / 3000 - (sum / 3000) * (sum / 3000));
+        float got  = nt_noise_var_q4(&n, 0) / 16.0f;
+        cut[l]     = n.mincutoff_q8[0] / 256.0f;
+        printf("  noise +/-%-2.0f: sigma^2 %6.2f / %6.2f (true %6.2f), mincutoff %.2f Hz\n", amps[l], got,
+               nt_noise_var_q4(&n, 1) / 16.0f, want, cut[l]);
+        assert(fabsf(got - want) < want * 0.25f + 0.25f && "variance estimate within 25%");
+        assert(abs((int)nt_noise_var_q4(&n, 1) - (int)nt_noise_var_q4(&n, 0)) < NT_NOISE_VAR_Q4(want) / 4 + 4);
+        jit_nominal[l] = rest_jitter(amps[l], MINCUTOFF);
+        jit_adapted[l] = rest_jitter(amps[l], cut[l]);
+    }
+    assert(cut[0] > MINCUTOFF && cut[2] < MINCUTOFF && "quiet pads cut higher, noisy ones lower");
+    assert(fabsf(cut[1] - MINCUTOFF) < 0.3f && "the reference noise keeps the nominal cutoff");
+    assert(cut[0] <= 4.0f && cut[2] >= 0.5f);
+    printf("  rest jitter nominal %.2f / %.2f / %.2f, adapted %.2f / %.2f / %.2f units\n", jit_nominal[0],
+           jit_nominal[1], jit_nominal[2], jit_adapted[0], jit_adapted[1], jit_adapted[2]);
+    assert(jit_adapted[2] < jit_nominal[2] * 0.95f && "a noisy pad must wobble less");
+    assert(jit_adapted[2] / jit_adapted[0] < jit_nominal[2] / jit_nominal[0]);
+    printf("  slow stroke lag, quiet pad: nominal %.1f, adapted %.1f units\n", slow_lag(MINCUTOFF), slow_lag(cut[0]));
+    assert(slow_lag(cut[0]) < slow_lag(MINCUTOFF) && "a quiet pad must lag less");
+
+    // Axes are estimated separately.
+    nt_noise_t n = NT_NOISE_INIT(NT_EURO_HZ_Q8(MINCUTOFF), NT_NOISE_VAR_Q4(NOISE_REF_VAR));
+    noise_session(&n, 2.0f, 16.0f, 20);
+    assert(n.mincutoff_q8[0] > NT_EURO_HZ_Q8(MINCUTOFF) && n.mincutoff_q8[1] < NT_EURO_HZ_Q8(MINCUTOFF));
+
+    // Moving contacts alone never feed the estimate.
+    nt_noise_t         m = NT_NOISE_INIT(NT_EURO_HZ_Q8(MINCUTOFF), NT_NOISE_VAR_Q4(NOISE_REF_VAR));
+    nt_noise_contact_t c = {0};
+    for (int i = 0; i < 2000; i++) {
+        nt_noise_update(&m, &c, 1024 + (int32_t)(600.0f * cosf(i * 0.05f)), 1024 + (int32_t)(600.0f * sinf(i * 0.05f)),
+                        &noise_cfg);
+    }
+    assert(m.mincutoff_q8[0] == NT_EURO_HZ_Q8(MINCUTOFF) && m.mincutoff_q8[1] == NT_EURO_HZ_Q8(MINCUTOFF));
+}
+
 int main(void) {
     test_seed_and_reset();
     test_jitter_attenuation();
     test_fast_ramp_low_lag();
+    test_frame_dt();
+    test_jittered_clock();
+    test_fixed_matches_float();
+    test_fixed_cost();
+    test_noise_estimate();
     printf("All filter tests passed\n");
     return 0;
 }
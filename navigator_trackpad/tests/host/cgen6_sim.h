@@ -0,0 +1,398 @@
+// Copyright 2026 ZSA Technology Labs, Inc <contact@zsa.io>
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// Host-side simulator of a Cirque Gen6 sensor, plugged into the mock bus as
+// its device. Include it after mock_bus.h, exactly once, from the test
+// translation unit.
+//
+// Models the memory-mapped register protocol the driver speaks:
+//   read   {0x01, 0x09, addr[4], cnt[2]} then [len lo, len hi, data..., cksum]
+//   write  {0x00, 0x09, addr[4], cnt[2], data..., cksum}
+// and the report stream on plain reads: while a finger is on the pad the
+// sensor produces a frame every CGEN6_SIM_FRAME_US into a small FIFO, with the
+// report ID picked by FEED_CONFIG4 (0x01 PTP, 0x09 absolute, 0x06 relative).
+// A lifted finger gets one tip=0 frame, then the stream goes quiet and plain
+// reads return the all-zero "nothing to report" packet. Any read takes the
+// queued frame, however short; with cgen6_sim.resend_partial set, a read
+// shorter than the frame leaves it queued instead, to be re-sent whole (the
+// behaviour length-prefixed reads rely on, not confirmed on hardware). The DR
+// line (active low) is asserted while the FIFO holds a frame.
+//
+// Fingers come from a scripted trace of keyframes, linearly interpolated per
+// contact id. Traces are given in the coordinates the sensor reports; the
+// XY_CONFIG swap/invert bits are stored but not applied.
+//
+// Faults: NACKs and timeouts through mock_bus_inject_fault(); bad checksums,
+// bad lengths and lost lift-off frames through cgen6_sim.fault; a power cycle
+// with cgen6_sim_power_cycle(). Turnaround violations (a transfer issued
+// before the sensor's post-transfer guard has run out) are counted.
+
+#pragma once
+
+#include "mock_bus.h"
+
+#ifndef CGEN6_SIM_FRAME_US
+#    define CGEN6_SIM_FRAME_US 8000
+#endif
+#ifndef CGEN6_SIM_DR_PIN
+#    ifdef NAVIGATOR_TRACKPAD_DR_PIN
+#        define CGEN6_SIM_DR_PIN NAVIGATOR_TRACKPAD_DR_PIN
+#    else
+#        define CGEN6_SIM_DR_PIN 0
+#    endif
+#endif
+
+#define CGEN6_SIM_REGS 32
+#define CGEN6_SIM_FIFO_DEPTH 4
+#define CGEN6_SIM_MAX_FINGERS 2
+#define CGEN6_SIM_PACKET_SIZE 17
+
+// Power-on register values.
+#define CGEN6_SIM_FEED_CONFIG4_DEFAULT 0x03  // relative (mouse) reports
+#define CGEN6_SIM_XY_CONFIG_DEFAULT 0x00
+#define CGEN6_SIM_SYS_CONFIG1_DEFAULT 0x00
+
+#define CGEN6_SIM_REG_FEED_CONFIG4 0x200E000B
+#define CGEN6_SIM_REG_XY_CONFIG 0x20080018
+#define CGEN6_SIM_REG_SYS_CONFIG1 0x20000008
+
+typedef struct {
+    uint8_t  id;
+    uint16_t x;
+    uint16_t y;
+} cgen6_sim_finger_t;
+
+// One keyframe of a trace: `count` fingers at t_ms after cgen6_sim_play().
+// Positions move linearly to the next keyframe for ids present in both; a
+// keyframe with count 0 lifts everything.
+typedef struct {
+    uint32_t           t_ms;
+    uint8_t            count;
+    cgen6_sim_finger_t fingers[CGEN6_SIM_MAX_FINGERS];
+} cgen6_sim_key_t;
+
+typedef struct {
+    uint32_t frames;            // frames produced into the FIFO
+    uint32_t frames_read;       // frames handed to the driver
+    uint32_t empty_reads;       // plain reads with nothing queued
+    uint32_t partial_reads;     // plain reads shorter than the queued frame
+    uint32_t overruns;          // frames dropped on a full FIFO
+    uint32_t mem_reads;
+    uint32_t mem_writes;
+    uint32_t bad_writes;        // writes with a bad checksum or length, ignored
+    uint32_t guard_violations;  // transfers issued inside the turnaround
+} cgen6_sim_stats_t;
+
+static struct {
+    struct {
+        uint32_t addr;
+        uint8_t  value;
+    } regs[CGEN6_SIM_REGS];
+    uint8_t nregs;
+
+    // Pending memory read (set by a read preamble, consumed by the next read).
+    bool     read_pending;
+    uint32_t read_addr;
+    uint16_t read_cnt;
+
+    // Report FIFO.
+    uint8_t  fifo[CGEN6_SIM_FIFO_DEPTH][CGEN6_SIM_PACKET_SIZE];
+    uint8_t  fifo_head, fifo_count;
+    uint64_t next_frame_us;
+    uint16_t scan_time;
+
+    // Trace playback.
+    const cgen6_sim_key_t *keys;
+    uint8_t                nkeys;
+    uint64_t               play_us;
+    cgen6_sim_finger_t     down[CGEN6_SIM_MAX_FINGERS];
+    uint8_t                ndown;
+    int32_t                last_x, last_y;  // finger 0, for relative reports
+
+    // Turnaround model.
+    uint64_t busy_until_us;
+
+    // A read shorter than the queued frame leaves it queued (see top).
+    bool resend_partial;
+
+    struct {
+        uint16_t corrupt_cksum;  // next N memory reads carry a bad checksum
+        uint16_t bad_length;     // next N memory reads carry a bad length
+        bool     drop_liftoff;   // lifted fingers get no tip=0 frame
+    } fault;
+
+    cgen6_sim_stats_t stats;
+} cgen6_sim;
+
+// --- Register memory ----------------------------------------------------------
+static inline uint8_t cgen6_sim_peek(uint32_t addr) {
+    for (uint8_t i = 0; i < cgen6_sim.nregs; i++) {
+        if (cgen6_sim.regs[i].addr == addr) {
+            return cgen6_sim.regs[i].value;
+        }
+    }
+    return 0;
+}
+
+static inline void cgen6_sim_poke(uint32_t addr, uint8_t value) {
+    for (uint8_t i = 0; i < cgen6_sim.nregs; i++) {
+        if (cgen6_sim.regs[i].addr == addr) {
+            cgen6_sim.regs[i].value = value;
+            return;
+        }
+    }
+    assert(cgen6_sim.nregs < CGEN6_SIM_REGS && "simulator register memory full");
+    cgen6_sim.regs[cgen6_sim.nregs].addr    = addr;
+    cgen6_sim.regs[cgen6_sim.nregs++].value = value;
+}
+
+// --- Report stream ------------------------------------------------------------
+static inline void cgen6_sim_dr_update(void) {
+    mock_gpio_level[CGEN6_SIM_DR_PIN] = cgen6_sim.fifo_count == 0;  // active low
+}
+
+static inline void cgen6_sim_fifo_push(const uint8_t *packet) {
+    if (cgen6_sim.fifo_count == CGEN6_SIM_FIFO_DEPTH) {
+        cgen6_sim.fifo_head = (uint8_t)((cgen6_sim.fifo_head + 1) % CGEN6_SIM_FIFO_DEPTH);
+        cgen6_sim.fifo_count--;
+        cgen6_sim.stats.overruns++;
+    }
+    uint8_t slot = (uint8_t)((cgen6_sim.fifo_head + cgen6_sim.fifo_count) % CGEN6_SIM_FIFO_DEPTH);
+    memcpy(cgen6_sim.fifo[slot], packet, CGEN6_SIM_PACKET_SIZE);
+    cgen6_sim.fifo_count++;
+    cgen6_sim.stats.frames++;
+}
+
+// Interpolated finger positions at `us`.
+static inline uint8_t cgen6_sim_trace_at(uint64_t us, cgen6_sim_finger_t *out) {
+    if (cgen6_sim.nkeys == 0 || us < cgen6_sim.play_us) {
+        return 0;
+    }
+    uint64_t               t = (us - cgen6_sim.play_us) / 1000;
+    uint8_t                k = 0;
+    while (k + 1 < cgen6_sim.nkeys && cgen6_sim.keys[k + 1].t_ms <= t) {
+        k++;
+    }
+    const cgen6_sim_key_t *a = &cgen6_sim.keys[k];
+    if (t < a->t_ms) {
+        return 0;
+    }
+    const cgen6_sim_key_t *b = k + 1 < cgen6_sim.nkeys ? &cgen6_sim.keys[k + 1] : NULL;
+    for (uint8_t i = 0; i < a->count; i++) {
+        out[i] = a->fingers[i];
+        if (!b) {
+            continue;
+        }
+        for (uint8_t j = 0; j < b->count; j++) {
+            if (b->fingers[j].id == a->fingers[i].id) {
+                int64_t span = (int64_t)b->t_ms - a->t_ms;
+                int64_t pos  = (int64_t)t - a->t_ms;
+                out[i].x     = (uint16_t)(a->fingers[i].x + ((int64_t)b->fingers[j].x - a->fingers[i].x) * pos / span);
+                out[i].y     = (uint16_t)(a->fingers[i].y + ((int64_t)b->fingers[j].y - a->fingers[i].y) * pos / span);
+            }
+        }
+    }
+    return a->count;
+}
+
+static inline void cgen6_sim_put_finger(uint8_t *p, const cgen6_sim_finger_t *f, bool tip) {
+    p[0] = (uint8_t)((f->id << 2) | (tip ? 0x02 : 0x00) | 0x01);
+    p[1] = f->x & 0xFF;
+    p[2] = f->x >> 8;
+    p[3] = f->y & 0xFF;
+    p[4] = f->y >> 8;
+}
+
+static inline int8_t cgen6_sim_clamp8(int32_t v) {
+    return (int8_t)(v > 127 ? 127 : v < -127 ? -127 : v);
+}
+
+// Build one frame from the fingers now down plus any that just lifted.
+static inline void cgen6_sim_make_frame(const cgen6_sim_finger_t *now, uint8_t n) {
+    uint8_t packet[CGEN6_SIM_PACKET_SIZE] = {CGEN6_SIM_PACKET_SIZE, 0x00};
+    uint8_t feed4                         = cgen6_sim_peek(CGEN6_SIM_REG_FEED_CONFIG4);
+    cgen6_sim.scan_time += CGEN6_SIM_FRAME_US / 100;
+
+    if (feed4 & 0x0C) {
+        // PTP / absolute: the contacts down now, then tip=0 for the lifted.
+        packet[2]    = (feed4 & 0x04) ? 0x01 : 0x09;
+        uint8_t slot = 0;
+        for (uint8_t i = 0; i < n && slot < CGEN6_SIM_MAX_FINGERS; i++) {
+            cgen6_sim_put_finger(&packet[3 + 5 * slot++], &now[i], true);
+        }
+        for (uint8_t i = 0; i < cgen6_sim.ndown && slot < CGEN6_SIM_MAX_FINGERS && !cgen6_sim.fault.drop_liftoff; i++) {
+            bool still = false;
+            for (uint8_t j = 0; j < n; j++) {
+                still |= now[j].id == cgen6_sim.down[i].id;
+            }
+            if (!still) {
+                cgen6_sim_put_finger(&packet[3 + 5 * slot++], &cgen6_sim.down[i], false);
+            }
+        }
+        packet[13] = cgen6_sim.scan_time & 0xFF;
+        packet[14] = cgen6_sim.scan_time >> 8;
+        packet[15] = n;
+        if (n == 0 && cgen6_sim.fault.drop_liftoff) {
+            return;
+        }
+    } else {
+        // Relative: finger 0 motion since the previous frame.
+        packet[2] = 0x06;
+        if (n > 0 && cgen6_sim.ndown > 0) {
+            packet[4] = (uint8_t)cgen6_sim_clamp8((int32_t)now[0].x - cgen6_sim.last_x);
+            packet[5] = (uint8_t)cgen6_sim_clamp8((int32_t)now[0].y - cgen6_sim.last_y);
+        }
+    }
+    cgen6_sim_fifo_push(packet);
+}
+
+// Advance the sensor to the current mock clock: produce every frame that is
+// due and update DR. Called from the bus handlers; a test loop should call it
+// too so DR rises on time while the driver is not on the bus.
+static inline void cgen6_sim_update(void) {
+    while (mock_clock_us >= cgen6_sim.next_frame_us) {
+        cgen6_sim_finger_t now[CGEN6_SIM_MAX_FINGERS];
+        uint8_t            n = cgen6_sim_trace_at(cgen6_sim.next_frame_us, now);
+        if (n > 0 || cgen6_sim.ndown > 0) {
+            cgen6_sim_make_frame(now, n);
+        }
+        memcpy(cgen6_sim.down, now, sizeof(now[0]) * n);
+        cgen6_sim.ndown = n;
+        if (n > 0) {
+            cgen6_sim.last_x = now[0].x;
+            cgen6_sim.last_y = now[0].y;
+        }
+        cgen6_sim.next_frame_us += CGEN6_SIM_FRAME_US;
+    }
+    cgen6_sim_dr_update();
+}
+
+// --- Bus handlers -------------------------------------------------------------
+static inline void cgen6_sim_begin_transfer(uint16_t guard_us) {
+    // mock_bus_begin() has already advanced the clock by the wire time.
+    if (mock_clock_us < cgen6_sim.busy_until_us) {
+        cgen6_sim.stats.guard_violations++;
+    }
+    cgen6_sim.busy_until_us = mock_clock_us + guard_us;
+    cgen6_sim_update();
+}
+
+static inline uint32_t cgen6_sim_addr(const uint8_t *preamble) {
+    return preamble[2] | (preamble[3] << 8) | ((uint32_t)preamble[4] << 16) | ((uint32_t)preamble[5] << 24);
+}
+
+static inline i2c_status_t cgen6_sim_write(const uint8_t *data, uint16_t len) {
+    if (len < 8 || data[1] != 0x09 || data[0] > 0x01) {
+        cgen6_sim_begin_transfer(0);
+        cgen6_sim.stats.bad_writes++;
+        return I2C_STATUS_SUCCESS;
+    }
+    uint32_t addr = cgen6_sim_addr(data);
+    uint16_t cnt  = data[6] | (data[7] << 8);
+    if (data[0] == 0x01) {
+        // Read preamble; the guard is armed by the read half.
+        cgen6_sim.read_pending = true;
+        cgen6_sim.read_addr    = addr;
+        cgen6_sim.read_cnt     = cnt;
+        return I2C_STATUS_SUCCESS;
+    }
+    cgen6_sim_begin_transfer(1000);
+    uint8_t cksum = 0;
+    for (uint16_t i = 0; i + 1 < len; i++) {
+        cksum += data[i];
+    }
+    if (len != cnt + 9 || cksum != data[len - 1]) {
+        cgen6_sim.stats.bad_writes++;
+        return I2C_STATUS_SUCCESS;
+    }
+    for (uint16_t i = 0; i < cnt; i++) {
+        cgen6_sim_poke(addr + i, data[8 + i]);
+    }
+    cgen6_sim.stats.mem_writes++;
+    return I2C_STATUS_SUCCESS;
+}
+
+static inline i2c_status_t cgen6_sim_read(uint8_t *data, uint16_t len) {
+    memset(data, 0, len);
+    if (cgen6_sim.read_pending) {
+        cgen6_sim.read_pending = false;
+        cgen6_sim_begin_transfer(250);
+        uint8_t  buf[MOCK_BUS_MAX_XFER];
+        uint16_t cnt   = cgen6_sim.read_cnt < MOCK_BUS_MAX_XFER - 3 ? cgen6_sim.read_cnt : MOCK_BUS_MAX_XFER - 3;
+        uint16_t total = cnt + 3;
+        uint8_t  cksum = 0;
+        buf[0]         = (uint8_t)(total & 0xFF);
+        buf[1]         = (uint8_t)(total >> 8);
+        if (cgen6_sim.fault.bad_length) {
+            cgen6_sim.fault.bad_length--;
+            buf[0]++;
+        }
+        for (uint16_t i = 0; i < cnt; i++) {
+            buf[2 + i] = cgen6_sim_peek(cgen6_sim.read_addr + i);
+        }
+        for (uint16_t i = 0; i < cnt + 2; i++) {
+            cksum += buf[i];
+        }
+        if (cgen6_sim.fault.corrupt_cksum) {
+            cgen6_sim.fault.corrupt_cksum--;
+            cksum ^= 0x5A;
+        }
+        buf[cnt + 2] = cksum;
+        memcpy(data, buf, len < total ? len : total);
+        cgen6_sim.stats.mem_reads++;
+        return I2C_STATUS_SUCCESS;
+    }
+
+    cgen6_sim_begin_transfer(len * 15);
+    if (cgen6_sim.fifo_count == 0) {
+        cgen6_sim.stats.empty_reads++;
+    } else {
+        memcpy(data, cgen6_sim.fifo[cgen6_sim.fifo_head], len < CGEN6_SIM_PACKET_SIZE ? len : CGEN6_SIM_PACKET_SIZE);
+        if (len < CGEN6_SIM_PACKET_SIZE) {
+            cgen6_sim.stats.partial_reads++;
+        } else {
+            cgen6_sim.stats.frames_read++;
+        }
+        // A partial read (e.g. just the length header) loses the frame,
+        // unless the sensor is modelled re-sending it whole.
+        if (len >= CGEN6_SIM_PACKET_SIZE || !cgen6_sim.resend_partial) {
+            cgen6_sim.fifo_head = (uint8_t)((cgen6_sim.fifo_head + 1) % CGEN6_SIM_FIFO_DEPTH);
+            cgen6_sim.fifo_count--;
+        }
+    }
+    cgen6_sim_dr_update();
+    return I2C_STATUS_SUCCESS;
+}
+
+// --- Control ------------------------------------------------------------------
+
+// Registers back to power-on values, FIFO and pending transfers dropped. The
+// trace keeps playing.
+static inline void cgen6_sim_power_cycle(void) {
+    cgen6_sim.nregs = 0;
+    cgen6_sim_poke(CGEN6_SIM_REG_FEED_CONFIG4, CGEN6_SIM_FEED_CONFIG4_DEFAULT);
+    cgen6_sim_poke(CGEN6_SIM_REG_XY_CONFIG, CGEN6_SIM_XY_CONFIG_DEFAULT);
+    cgen6_sim_poke(CGEN6_SIM_REG_SYS_CONFIG1, CGEN6_SIM_SYS_CONFIG1_DEFAULT);
+    cgen6_sim.read_pending  = false;
+    cgen6_sim.fifo_head     = 0;
+    cgen6_sim.fifo_count    = 0;
+    cgen6_sim.ndown         = 0;
+    cgen6_sim.busy_until_us = 0;
+    cgen6_sim_dr_update();
+}
+
+// Reset the mock bus and clock and attach a freshly powered sensor.
+static inline void cgen6_sim_reset(void) {
+    mock_bus_reset();
+    memset(&cgen6_sim, 0, sizeof cgen6_sim);
+    mock_bus_set_device((mock_bus_device_t){.write = cgen6_sim_write, .read = cgen6_sim_read});
+    cgen6_sim_power_cycle();
+}
+
+// Start playing a trace now. The keys must outlive the playback.
+static inline void cgen6_sim_play(const cgen6_sim_key_t *keys, uint8_t nkeys) {
+    cgen6_sim.keys          = keys;
+    cgen6_sim.nkeys         = nkeys;
+    cgen6_sim.play_us       = mock_clock_us;
+    cgen6_sim.next_frame_us = mock_clock_us;
+}
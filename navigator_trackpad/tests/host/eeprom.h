@@ -0,0 +1,14 @@
+// Copyright 2026 ZSA Technology Labs, Inc <contact@zsa.io>
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// Host shim for QMK's eeprom.h, backed by mock_eeprom[] in mock_bus.h.
+
+#pragma once
+
+#include <stddef.h>
+#include "nt_host.h"
+
+#define TOTAL_EEPROM_BYTE_COUNT 4096  // MOCK_EEPROM_SIZE
+
+void eeprom_read_block(void *buf, const void *addr, size_t len);
+void eeprom_update_block(const void *buf, void *addr, size_t len);
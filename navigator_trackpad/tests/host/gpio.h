@@ -0,0 +1,17 @@
+// Copyright 2026 ZSA Technology Labs, Inc <contact@zsa.io>
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// Host shim for QMK's gpio.h. Pin levels live in mock_bus.h (mock_gpio_level)
+// so a test can drive inputs such as the trackpad's data-ready line.
+
+#pragma once
+
+#include "nt_host.h"
+
+typedef uint8_t pin_t;
+
+#define MOCK_GPIO_PINS 8
+
+void gpio_set_pin_input(pin_t pin);
+void gpio_set_pin_input_high(pin_t pin);
+bool gpio_read_pin(pin_t pin);
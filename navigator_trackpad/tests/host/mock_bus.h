@@ -0,0 +1,241 @@
+// Copyright 2026 ZSA Technology Labs, Inc <contact@zsa.io>
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// Host-side mock I2C bus, GPIO and fake clock for the Navigator trackpad
+// driver. Provides the bodies for the i2c_master.h / gpio.h / timer.h / wait.h
+// shims. Include
+// it exactly once, from the test translation unit.
+//
+// Time is kept in microseconds. Every bus transaction advances the clock by a
+// modelled wire time (400 kHz, 9 bits per byte plus the address byte) and
+// every wait_us()/wait_ms() advances it by the requested amount. The two are
+// tallied separately so a test can tell time spent moving bytes from time the
+// driver spent spinning.
+//
+// EEPROM is a plain byte array (mock_eeprom), blank (0xFF) until written.
+//
+// The device on the other end of the bus is pluggable. By default reads are
+// served from a script queue (mock_bus_push_read) and writes are recorded;
+// a test can install its own handlers with mock_bus_set_device().
+
+#pragma once
+
+#include <assert.h>
+#include <string.h>
+#include "eeprom.h"
+#include "gpio.h"
+#include "i2c_master.h"
+#include "timer.h"
+#include "wait.h"
+
+#define MOCK_BUS_SCRIPT_DEPTH 16
+#define MOCK_BUS_MAX_XFER 32
+#define MOCK_EEPROM_SIZE 4096
+
+typedef struct {
+    // Called with the bytes the driver transmits (write, or the write half of
+    // a write-then-read). Returns the status the driver should see.
+    i2c_status_t (*write)(const uint8_t *data, uint16_t len);
+    // Called to fill the bytes the driver receives.
+    i2c_status_t (*read)(uint8_t *data, uint16_t len);
+} mock_bus_device_t;
+
+typedef struct {
+    uint32_t transactions;
+    uint32_t bytes;   // bytes on the wire, both directions
+    uint64_t bus_us;  // modelled wire time
+    uint64_t spin_us; // time spent in wait_us()/wait_ms()
+} mock_bus_stats_t;
+
+static uint64_t          mock_clock_us = 0;
+static mock_bus_stats_t  mock_bus_stats;
+static bool              mock_bus_present = true;
+static i2c_status_t      mock_bus_fault_status;
+static uint16_t          mock_bus_fault_count;
+static mock_bus_device_t mock_bus_device;
+static bool              mock_gpio_level[MOCK_GPIO_PINS];
+static uint8_t           mock_eeprom[MOCK_EEPROM_SIZE];
+static uint32_t          mock_eeprom_reads;
+
+// --- Default scripted device -------------------------------------------------
+static uint8_t  mock_script[MOCK_BUS_SCRIPT_DEPTH][MOCK_BUS_MAX_XFER];
+static uint16_t mock_script_len[MOCK_BUS_SCRIPT_DEPTH];
+static uint8_t  mock_script_head, mock_script_tail;
+static uint8_t  mock_last_write[MOCK_BUS_MAX_XFER];
+static uint16_t mock_last_write_len;
+
+static inline i2c_status_t mock_script_write(const uint8_t *data, uint16_t len) {
+    mock_last_write_len = len < MOCK_BUS_MAX_XFER ? len : MOCK_BUS_MAX_XFER;
+    memcpy(mock_last_write, data, mock_last_write_len);
+    return I2C_STATUS_SUCCESS;
+}
+
+// Serves the next scripted response; an empty queue reads as all zeros (the
+// sensor's "nothing to report" packet).
+static inline i2c_status_t mock_script_read(uint8_t *data, uint16_t len) {
+    memset(data, 0, len);
+    if (mock_script_head != mock_script_tail) {
+        uint8_t  slot = mock_script_head;
+        uint16_t n    = mock_script_len[slot] < len ? mock_script_len[slot] : len;
+        memcpy(data, mock_script[slot], n);
+        mock_script_head = (uint8_t)((mock_script_head + 1) % MOCK_BUS_SCRIPT_DEPTH);
+    }
+    return I2C_STATUS_SUCCESS;
+}
+
+static inline void mock_bus_push_read(const uint8_t *data, uint16_t len) {
+    assert(len <= MOCK_BUS_MAX_XFER);
+    memcpy(mock_script[mock_script_tail], data, len);
+    mock_script_len[mock_script_tail] = len;
+    mock_script_tail                  = (uint8_t)((mock_script_tail + 1) % MOCK_BUS_SCRIPT_DEPTH);
+    assert(mock_script_tail != mock_script_head && "mock bus script overflow");
+}
+
+// Queue a well-formed memory-read response: [len lo, len hi, data..., cksum].
+static inline void mock_bus_push_memory(const uint8_t *data, uint16_t cnt) {
+    uint8_t  buf[MOCK_BUS_MAX_XFER];
+    uint16_t len   = cnt + 3;
+    uint8_t  cksum = 0;
+    buf[0]         = (uint8_t)(len & 0xFF);
+    buf[1]         = (uint8_t)(len >> 8);
+    memcpy(&buf[2], data, cnt);
+    for (uint16_t i = 0; i < cnt + 2; i++) {
+        cksum += buf[i];
+    }
+    buf[cnt + 2] = cksum;
+    mock_bus_push_read(buf, len);
+}
+
+// --- Control -----------------------------------------------------------------
+static inline void mock_bus_reset(void) {
+    mock_clock_us = 0;
+    memset(&mock_bus_stats, 0, sizeof mock_bus_stats);
+    mock_bus_present      = true;
+    mock_bus_fault_count  = 0;
+    mock_bus_device.write = mock_script_write;
+    mock_bus_device.read  = mock_script_read;
+    mock_script_head = mock_script_tail = 0;
+    mock_last_write_len                 = 0;
+    for (uint8_t i = 0; i < MOCK_GPIO_PINS; i++) {
+        mock_gpio_level[i] = true;  // inputs idle high (pulled up)
+    }
+    memset(mock_eeprom, 0xFF, sizeof mock_eeprom);
+    mock_eeprom_reads = 0;
+}
+
+static inline void mock_bus_set_device(mock_bus_device_t dev) {
+    mock_bus_device = dev;
+}
+
+// Fail the next `count` transactions with `status` (I2C_STATUS_ERROR models a
+// NACK, I2C_STATUS_TIMEOUT a stuck bus).
+static inline void mock_bus_inject_fault(i2c_status_t status, uint16_t count) {
+    mock_bus_fault_status = status;
+    mock_bus_fault_count  = count;
+}
+
+static inline void mock_clock_advance_us(uint64_t us) {
+    mock_clock_us += us;
+}
+
+static inline void mock_clock_advance_ms(uint32_t ms) {
+    mock_clock_us += (uint64_t)ms * 1000;
+}
+
+// --- Shim bodies -------------------------------------------------------------
+uint32_t timer_read32(void) {
+    return (uint32_t)(mock_clock_us / 1000);
+}
+
+void wait_us(uint32_t us) {
+    mock_clock_us += us;
+    mock_bus_stats.spin_us += us;
+}
+
+void wait_ms(uint32_t ms) {
+    wait_us(ms * 1000);
+}
+
+void eeprom_read_block(void *buf, const void *addr, size_t len) {
+    assert((uintptr_t)addr + len <= MOCK_EEPROM_SIZE);
+    memcpy(buf, &mock_eeprom[(uintptr_t)addr], len);
+    mock_eeprom_reads++;
+}
+
+void eeprom_update_block(const void *buf, void *addr, size_t len) {
+    assert((uintptr_t)addr + len <= MOCK_EEPROM_SIZE);
+    memcpy(&mock_eeprom[(uintptr_t)addr], buf, len);
+}
+
+void gpio_set_pin_input(pin_t pin) {
+    assert(pin < MOCK_GPIO_PINS);
+}
+
+void gpio_set_pin_input_high(pin_t pin) {
+    assert(pin < MOCK_GPIO_PINS);
+}
+
+bool gpio_read_pin(pin_t pin) {
+    assert(pin < MOCK_GPIO_PINS);
+    return mock_gpio_level[pin];
+}
+
+static inline i2c_status_t mock_bus_begin(uint16_t bytes) {
+    uint64_t wire = (uint64_t)(bytes + 1) * 45 / 2;  // 22.5 us per byte at 400 kHz
+    mock_bus_stats.transactions++;
+    mock_bus_stats.bytes += bytes;
+    mock_bus_stats.bus_us += wire;
+    mock_clock_us += wire;
+    if (!mock_bus_present) {
+        return I2C_STATUS_ERROR;
+    }
+    if (mock_bus_fault_count > 0) {
+        mock_bus_fault_count--;
+        return mock_bus_fault_status;
+    }
+    return I2C_STATUS_SUCCESS;
+}
+
+void i2c_init(void) {}
+
+i2c_status_t i2c_ping_address(uint8_t address, uint16_t timeout) {
+    (void)address;
+    (void)timeout;
+    return mock_bus_begin(0);
+}
+
+i2c_status_t i2c_transmit(uint8_t address, const uint8_t *data, uint16_t length, uint16_t timeout) {
+    (void)address;
+    (void)timeout;
+    i2c_status_t res = mock_bus_begin(length);
+    if (res != I2C_STATUS_SUCCESS) {
+        return res;
+    }
+    return mock_bus_device.write(data, length);
+}
+
+i2c_status_t i2c_receive(uint8_t address, uint8_t *data, uint16_t length, uint16_t timeout) {
+    (void)address;
+    (void)timeout;
+    i2c_status_t res = mock_bus_begin(length);
+    if (res != I2C_STATUS_SUCCESS) {
+        memset(data, 0xFF, length);  // released SDA reads as ones
+        return res;
+    }
+    return mock_bus_device.read(data, length);
+}
+
+i2c_status_t i2c_transmit_and_receive(uint8_t address, const uint8_t *tx_data, uint16_t tx_length, uint8_t *rx_data, uint16_t rx_length, uint16_t timeout) {
+    (void)address;
+    (void)timeout;
+    i2c_status_t res = mock_bus_begin(tx_length + rx_length);
+    if (res != I2C_STATUS_SUCCESS) {
+        memset(rx_data, 0xFF, rx_length);
+        return res;
+    }
+    res = mock_bus_device.write(tx_data, tx_length);
+    if (res != I2C_STATUS_SUCCESS) {
+        return res;
+    }
+    return mock_bus_device.read(rx_data, rx_length);
+}
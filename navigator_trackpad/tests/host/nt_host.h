@@ -0,0 +1,20 @@
+// Copyright 2026 ZSA Technology Labs, Inc <contact@zsa.io>
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// Common prelude for the host-side QMK shims in this directory. Lets the
+// driver sources (navigator_trackpad_common.c / _ptp.c) compile on Linux with
+// -Inavigator_trackpad/tests/host in place of the real QMK include paths.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// QMK's community-module and feature switches compare against TRUE/FALSE.
+#ifndef TRUE
+#    define TRUE 1
+#endif
+#ifndef FALSE
+#    define FALSE 0
+#endif
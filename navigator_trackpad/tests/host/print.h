@@ -0,0 +1,10 @@
+// Copyright 2026 ZSA Technology Labs, Inc <contact@zsa.io>
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// Host shim for QMK's print.h: console output goes to stdout.
+
+#pragma once
+
+#include "nt_host.h"
+
+#define uprintf printf
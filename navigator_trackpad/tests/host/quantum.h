@@ -0,0 +1,13 @@
+// Copyright 2026 ZSA Technology Labs, Inc <contact@zsa.io>
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// Host shim for QMK's quantum.h: just the pieces the trackpad driver uses.
+
+#pragma once
+
+#include <string.h>
+#include "nt_host.h"
+#include "gpio.h"
+#include "i2c_master.h"
+#include "timer.h"
+#include "wait.h"
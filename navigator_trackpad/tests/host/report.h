@@ -0,0 +1,32 @@
+// Copyright 2026 ZSA Technology Labs, Inc <contact@zsa.io>
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// Host shim for the digitizer report types from ZSA's QMK report.h. Mirrors
+// the byte layout the trackpad driver builds.
+
+#pragma once
+
+#include "nt_host.h"
+
+#define DIGITIZER_TOUCHPAD_MOUSE_REPORT_ID 0x02
+
+typedef struct __attribute__((packed)) {
+    uint8_t confidence_tip;
+    uint8_t contact_id;
+    uint16_t x;
+    uint16_t y;
+} report_digitizer_touchpad_finger_t;
+
+typedef struct __attribute__((packed)) {
+    uint8_t                            report_id;
+    report_digitizer_touchpad_finger_t fingers[2];
+    uint16_t                           scan_time;
+    uint8_t                            contact_count_buttons;
+} report_digitizer_touchpad_t;
+
+typedef struct __attribute__((packed)) {
+    uint8_t report_id;
+    uint8_t buttons;
+    int8_t  x;
+    int8_t  y;
+} report_digitizer_touchpad_mouse_t;
@@ -0,0 +1,14 @@
+// Copyright 2026 ZSA Technology Labs, Inc <contact@zsa.io>
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// Host shim for QMK's timer.h, backed by the fake clock in mock_bus.h.
+
+#pragma once
+
+#include "nt_host.h"
+
+uint32_t timer_read32(void);
+
+static inline uint32_t timer_elapsed32(uint32_t last) {
+    return timer_read32() - last;
+}
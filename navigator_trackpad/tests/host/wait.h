@@ -0,0 +1,12 @@
+// Copyright 2026 ZSA Technology Labs, Inc <contact@zsa.io>
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// Host shim for QMK's wait.h. Waiting advances the fake clock in mock_bus.h
+// and is tallied as spin time, so tests can see every busy-wait.
+
+#pragma once
+
+#include "nt_host.h"
+
+void wait_us(uint32_t us);
+void wait_ms(uint32_t ms);
@@ -0,0 +1,158 @@
+// Copyright 2026 ZSA Technology Labs, Inc <contact@zsa.io>
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// Host test for the distortion-grid fitter (tools/nt_lut_fit.h) and the
+// firmware's loader for a per-unit table (nt_lut_load).
+// Build & run from the module root:
+//   gcc -Wall -O2 -Inavigator_trackpad/tests/host -o /tmp/nt_lut_fit_test navigator_trackpad/tests/lut_fit_test.c -lm
+//   /tmp/nt_lut_fit_test
+//
+// Warps straight synthetic strokes with a known smooth field (plus sensor
+// noise), fits 9x9 and 17x17 grids, and checks on held-out strokes that the
+// fitted correction makes them far straighter. Then stores the fit as a blob
+// and verifies the firmware loads it into cells that reproduce the fit, and
+// that a corrupt, foreign or oversized blob is refused.
+
+#include <assert.h>
+#include <stdio.h>
+#include "../navigator_trackpad_lut.h"
+#include "../tools/nt_lut_fit.h"
+
+#define STROKES 1000
+#define HELD_OUT 100
+#define MAX_PTS 200
+
+static nt_fit_pt_t     pts[STROKES + HELD_OUT][MAX_PTS];
+static nt_fit_stroke_t strokes[STROKES + HELD_OUT];
+
+static uint32_t rng = 12345;
+static double   rnd(void) {  // uniform [0, 1)
+    rng = rng * 1664525u + 1013904223u;
+    return (rng >> 8) / 16777216.0;
+}
+
+// The "sensor" distortion: a smooth ripple of up to ~30 units, in the spirit
+// of the measured ~1 mm diagonal bow.
+static void warp(double x, double y, double *wx, double *wy) {
+    *wx = 22 * sin(x / 2048 * 2 * M_PI * 1.3) * cos(y / 2048 * M_PI) + 8 * sin(y / 2048 * 2 * M_PI * 2.0);
+    *wy = 20 * cos(x / 2048 * 2 * M_PI * 0.8) * sin(y / 2048 * 2 * M_PI * 1.1) - 9 * cos(x / 2048 * 2 * M_PI * 1.7);
+}
+
+// Straight strokes in random directions, reported through the warp.
+static void make_strokes(void) {
+    for (int s = 0; s < STROKES + HELD_OUT; s++) {
+        double x0 = 100 + rnd() * 1848, y0 = 100 + rnd() * 1848, th = rnd() * M_PI;
+        double len = 500 + rnd() * 1200, c = cos(th), sn = sin(th);
+        int    n   = 0;
+        for (double t = -len / 2; t <= len / 2 && n < MAX_PTS; t += 12) {
+            double x = x0 + t * c, y = y0 + t * sn, wx, wy;
+            if (x < 0 || x > 2048 || y < 0 || y > 2048) continue;
+            warp(x, y, &wx, &wy);
+            pts[s][n++] = (nt_fit_pt_t){x + wx + (rnd() - 0.5) * 2, y + wy + (rnd() - 0.5) * 2};
+        }
+        strokes[s] = (nt_fit_stroke_t){pts[s], n};
+    }
+}
+
+// 1. The fit straightens held-out strokes at both grid sizes.
+static int8_t ex9[81], ey9[81], ex17[289], ey17[289];
+
+static void test_fit_straightens(void) {
+    const nt_fit_stroke_t *held = &strokes[STROKES];
+    double                 before = nt_fit_straightness(held, HELD_OUT, 9, NULL, NULL);
+
+    nt_fit_opts_t opt = NT_FIT_DEFAULTS;
+    assert(nt_fit_lut(strokes, STROKES, &opt, ex9, ey9) == 0);
+    double after9 = nt_fit_straightness(held, HELD_OUT, 9, ex9, ey9);
+
+    opt.grid = 17;
+    assert(nt_fit_lut(strokes, STROKES, &opt, ex17, ey17) == 0);
+    double after17 = nt_fit_straightness(held, HELD_OUT, 17, ex17, ey17);
+
+    printf("  held-out RMS distance from line: uncorrected %.2f, 9x9 fit %.2f, 17x17 fit %.2f units\n", before,
+           after9, after17);
+    fflush(stdout);
+    assert(after9 < before * 0.35 && "a 9x9 fit must remove most of the bow");
+    assert(after17 < after9 && "a finer grid must follow the warp more closely");
+    for (int k = 0; k < 289; k++) {
+        assert(abs(ex17[k]) <= NT_LUT_BLOB_BOUND && abs(ey17[k]) <= NT_LUT_BLOB_BOUND);
+    }
+}
+
+// --- Blob storage --------------------------------------------------------------
+static uint8_t store[NT_LUT_BLOB_SIZE(33)];
+
+static void store_read(void *dst, uint16_t offset, uint16_t len) {
+    assert(offset + len <= sizeof(store));
+    memcpy(dst, &store[offset], len);
+}
+
+// Field of a loaded table at a logical point, in units, via its cells.
+static void cells_field(const nt_lut_t *lut, double x, double y, double *fx, double *fy) {
+    double cell = (double)(1 << lut->shift);
+    int    ix = (int)(x / cell), iy = (int)(y / cell);
+    if (ix >= lut->cells) ix = lut->cells - 1;
+    if (iy >= lut->cells) iy = lut->cells - 1;
+    int32_t              tx = (int32_t)((x / cell - ix) * 256), ty = (int32_t)((y / cell - iy) * 256);
+    const nt_lut_cell_t *cx = &lut->x[ix * lut->cells + iy], *cy = &lut->y[ix * lut->cells + iy];
+    *fx = nt_lut_cell_eval(cx, tx, ty) / 65536.0;
+    *fy = nt_lut_cell_eval(cy, tx, ty) / 65536.0;
+}
+
+// 2. A stored 17x17 fit loads into cells matching the fitted field.
+static void test_blob_loads(void) {
+    static nt_lut_cell_t cells[NT_LUT_CELL_COUNT(17)];
+    nt_lut_t             lut = {0};
+    nt_fit_to_blob(17, ex17, ey17, store);
+    assert(nt_lut_blob_valid(store, NT_LUT_BLOB_SIZE(17)));
+    assert(nt_lut_load(&lut, cells, NT_LUT_CELL_COUNT(17), store_read));
+    assert(lut.cells == 16 && lut.shift == 7);
+
+    double dx[289], dy[289], worst = 0;
+    for (int k = 0; k < 289; k++) dx[k] = ex17[k], dy[k] = ey17[k];
+    for (int x = 0; x < 2048; x += 7) {
+        for (int y = 0; y < 2048; y += 7) {
+            nt_fit_pt_t p = nt_fit_correct(17, dx, dy, (nt_fit_pt_t){x, y});
+            double      fx, fy;
+            cells_field(&lut, x, y, &fx, &fy);
+            double e = fmax(fabs((x - p.x) - fx), fabs((y - p.y) - fy));
+            if (e > worst) worst = e;
+        }
+    }
+    printf("  17x17 blob: %u bytes, loaded field within %.3f units of the fit\n", NT_LUT_BLOB_SIZE(17), worst);
+    assert(worst < 0.5);
+}
+
+// 3. Corrupt, blank or oversized blobs are refused and leave the table alone;
+// a blob the loader would refuse is never valid to store.
+static void test_blob_refused(void) {
+    static nt_lut_cell_t cells[NT_LUT_CELL_COUNT(17)];
+    nt_lut_t             lut = NT_LUT_COMPILED;
+
+    nt_fit_to_blob(9, ex9, ey9, store);
+    store[NT_LUT_BLOB_HEADER + 40] ^= 0x01;
+    assert(!nt_lut_load(&lut, cells, NT_LUT_CELL_COUNT(17), store_read) && "checksum mismatch");
+
+    memset(store, 0xFF, sizeof(store));
+    assert(!nt_lut_load(&lut, cells, NT_LUT_CELL_COUNT(17), store_read) && "blank EEPROM");
+
+    nt_fit_to_blob(17, ex17, ey17, store);
+    assert(!nt_lut_load(&lut, cells, NT_LUT_CELL_COUNT(9), store_read) && "too big for the RAM table");
+
+    nt_fit_to_blob(9, ex9, ey9, store);
+    store[NT_LUT_BLOB_HEADER] = 100;  // out of bounds node, re-sealed
+    nt_lut_blob_seal(store, 9);
+    assert(!nt_lut_load(&lut, cells, NT_LUT_CELL_COUNT(17), store_read) && "node out of bounds");
+    assert(!nt_lut_blob_valid(store, NT_LUT_BLOB_SIZE(9)) && "the save path must refuse it too");
+
+    assert(lut.x == NT_LUT_COMPILED.x && "a refused blob must not touch the table");
+}
+
+int main(void) {
+    make_strokes();
+    test_fit_straightens();
+    test_blob_loads();
+    test_blob_refused();
+    printf("All LUT fit tests passed\n");
+    return 0;
+}
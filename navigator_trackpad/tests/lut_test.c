@@ -0,0 +1,91 @@
+// Copyright 2026 ZSA Technology Labs, Inc <contact@zsa.io>
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// Host test for the distortion-correction LUT.
+// Build & run from the module root:
+//   gcc -Wall -Inavigator_trackpad/tests/host -o /tmp/nt_lut_test navigator_trackpad/tests/lut_test.c -lm
+//   /tmp/nt_lut_test
+//
+// Verifies that the compile-time cell slopes reproduce every grid node, and
+// that the integer correction agrees with the float reference to one logical
+// unit at every point of the 0..TRACKPAD_LOGICAL_MAX grid. Prints the cost of
+// both per point for comparison.
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../navigator_trackpad_lut.h"
+
+// 1. Each cell evaluated at its corners lands exactly on the four nodes.
+static void test_cells_match_nodes(void) {
+    for (int i = 0; i < NT_LUT_G - 1; i++) {
+        for (int j = 0; j < NT_LUT_G - 1; j++) {
+            for (int cx = 0; cx < 2; cx++) {
+                for (int cy = 0; cy < 2; cy++) {
+                    int32_t ex = nt_lut_cell_eval(&NT_LUT_CELLS_X[i][j], cx * 256, cy * 256);
+                    int32_t ey = nt_lut_cell_eval(&NT_LUT_CELLS_Y[i][j], cx * 256, cy * 256);
+                    assert(ex == NT_LUT_EX[i + cx][j + cy] * 65536);
+                    assert(ey == NT_LUT_EY[i + cx][j + cy] * 65536);
+                }
+            }
+        }
+    }
+}
+
+// 2. Full-pad sweep: integer and float agree to one unit everywhere.
+static void test_sweep_matches_float(void) {
+    uint32_t mismatches = 0;
+    int      worst      = 0;
+    for (uint32_t x = 0; x <= TRACKPAD_LOGICAL_MAX; x++) {
+        for (uint32_t y = 0; y <= TRACKPAD_LOGICAL_MAX; y++) {
+            uint16_t ix = x, iy = y, fx = x, fy = y;
+            nt_lut_correct(&ix, &iy);
+            nt_lut_correct_float(&fx, &fy);
+            int d = abs((int)ix - fx) > abs((int)iy - fy) ? abs((int)ix - fx) : abs((int)iy - fy);
+            if (d) mismatches++;
+            if (d > worst) worst = d;
+        }
+    }
+    uint32_t n = (TRACKPAD_LOGICAL_MAX + 1) * (TRACKPAD_LOGICAL_MAX + 1);
+    printf("  sweep: %u points, %u differ by one unit (%.3f%%), max diff %d\n", n, mismatches,
+           100.0 * mismatches / n, worst);
+    assert(worst <= 1 && "integer correction must match float to one unit");
+}
+
+// 3. Per-point cost, for reference (the host has an FPU; an FPU-less MCU pays
+//    soft-float calls for every float operation).
+static double ns_per_point(bool integer) {
+    volatile uint32_t sink = 0;
+    struct timespec   t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (uint32_t x = 0; x <= TRACKPAD_LOGICAL_MAX; x += 3) {
+        for (uint32_t y = 0; y <= TRACKPAD_LOGICAL_MAX; y += 3) {
+            uint16_t px = x, py = y;
+            if (integer) {
+                nt_lut_correct(&px, &py);
+            } else {
+                nt_lut_correct_float(&px, &py);
+            }
+            sink += px + py;
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    (void)sink;
+    double n = (TRACKPAD_LOGICAL_MAX / 3 + 1) * (TRACKPAD_LOGICAL_MAX / 3 + 1);
+    return ((t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec)) / n;
+}
+
+static void test_cost(void) {
+    double f = ns_per_point(false), i = ns_per_point(true);
+    printf("  cost per point (host): float %.1f ns, integer %.1f ns; cell tables %u bytes\n", f, i,
+           (unsigned)(sizeof(NT_LUT_CELLS_X) + sizeof(NT_LUT_CELLS_Y)));
+}
+
+int main(void) {
+    test_cells_match_nodes();
+    test_sweep_matches_float();
+    test_cost();
+    printf("All LUT tests passed\n");
+    return 0;
+}
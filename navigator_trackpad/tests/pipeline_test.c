@@ -0,0 +1,353 @@
+// Copyright 2026 ZSA Technology Labs, Inc <contact@zsa.io>
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// Host test for the frame pipeline (navigator_trackpad_pipeline.c) on its own:
+// no bus, no clock, no task.
+// Build & run from the module root:
+//   gcc -Wall -O2 -Inavigator_trackpad/tests/host -o /tmp/nt_pipeline_test navigator_trackpad/tests/pipeline_test.c -lm
+//   /tmp/nt_pipeline_test
+// and again with -DNAVIGATOR_TRACKPAD_SCROLL=TRUE for the two-finger scroll.
+//
+// Verifies that a swipe comes out as a moving PTP contact released with tip=0,
+// that two pipelines fed interleaved traces produce exactly what each produces
+// alone (all state is in nt_pipeline_t), that mouse mode turns a tap into a
+// click and a mode change releases it, that a flick in mouse mode reports
+// every count of its motion (what an 8-bit report cannot carry goes out over
+// the following frames), that mouse mode follows a contact through slot swaps
+// and lift-offs without jumping and carries no more jitter than PTP, that two
+// fingers scroll instead when NAVIGATOR_TRACKPAD_SCROLL is on, that a resting
+// finger is reported only at the keep-alive rate while any change goes out at
+// once, and reports the frame throughput.
+
+#include <assert.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../navigator_trackpad_pipeline.c"
+
+#define FRAME_MS 8
+
+static cgen6_report_t finger(uint8_t id, uint16_t x, uint16_t y, uint16_t scan_time) {
+    cgen6_report_t f = {.scan_time = scan_time, .contact_count = 1};
+    f.fingers[0]     = (cgen6_finger_t){.tip = 1, .confidence = 1, .id = id, .x = x, .y = y};
+    return f;
+}
+
+static uint16_t ptp_x(const nt_pipeline_out_t *out) {
+    return out->ptp[PTP_FINGER0_OFFSET + 2] | out->ptp[PTP_FINGER0_OFFSET + 3] << 8;
+}
+
+static uint16_t ptp_y(const nt_pipeline_out_t *out) {
+    return out->ptp[PTP_FINGER0_OFFSET + 4] | out->ptp[PTP_FINGER0_OFFSET + 5] << 8;
+}
+
+static bool ptp_tip(const nt_pipeline_out_t *out) {
+    return out->ptp[PTP_FINGER0_OFFSET] & 0x02;
+}
+
+// 1. A swipe moves the contact rightwards, then a lift releases it.
+static void test_swipe(void) {
+    nt_pipeline_t     st;
+    nt_pipeline_out_t out;
+    nt_pipeline_init(&st, NULL);
+
+    uint16_t last_x = 0;
+    for (int i = 0; i < 40; i++) {
+        cgen6_report_t f = finger(5, 500 + i * 25, 1100, i * FRAME_MS * 10);
+        nt_pipeline_process(&st, &f, TRACKPAD_INPUT_MODE_PTP, i * FRAME_MS, &out);
+        assert(out.ptp_send && out.active && out.mouse_count == 0);
+        assert(out.ptp[0] == PTP_REPORT_ID && ptp_tip(&out));
+        assert(ptp_x(&out) >= last_x);
+        last_x = ptp_x(&out);
+    }
+    assert(last_x > 1000);
+
+    cgen6_report_t lift = {0};
+    nt_pipeline_process(&st, &lift, TRACKPAD_INPUT_MODE_PTP, 40 * FRAME_MS, &out);
+    assert(out.ptp_send && !ptp_tip(&out) && "a lift must release the contact");
+    nt_pipeline_process(&st, &lift, TRACKPAD_INPUT_MODE_PTP, 41 * FRAME_MS, &out);
+    assert(!out.ptp_send && !out.active && "nothing to send once idle");
+    assert(st.contacts.count == 0);
+}
+
+// 2. Two pipelines stepped in lockstep on different traces match runs of each
+// alone, byte for byte.
+static void run_trace(nt_pipeline_t *st, int k, int i, nt_pipeline_out_t *out) {
+    cgen6_report_t f = (i % 30 < 25) ? finger(k + 1, 400 + k * 300 + (i % 30) * (k + 2) * 9, 900 + k * 200, i * 80)
+                                     : (cgen6_report_t){0};
+    nt_pipeline_process(st, &f, TRACKPAD_INPUT_MODE_PTP, i * FRAME_MS, out);
+}
+
+static void test_state_is_explicit(void) {
+    static nt_pipeline_out_t alone[2][300];
+    nt_pipeline_t            st[2];
+    for (int k = 0; k < 2; k++) {
+        nt_pipeline_init(&st[k], NULL);
+        for (int i = 0; i < 300; i++) run_trace(&st[k], k, i, &alone[k][i]);
+    }
+
+    nt_pipeline_init(&st[0], NULL);
+    nt_pipeline_init(&st[1], NULL);
+    for (int i = 0; i < 300; i++) {
+        for (int k = 0; k < 2; k++) {
+            nt_pipeline_out_t out;
+            run_trace(&st[k], k, i, &out);
+            assert(memcmp(&out, &alone[k][i], sizeof(out)) == 0);
+        }
+    }
+}
+
+// 3. Mouse mode: a short still touch is a click on lift; a mode change with
+// the click still pending sends the release.
+static void test_mouse_tap(void) {
+    nt_pipeline_t     st;
+    nt_pipeline_out_t out;
+    cgen6_report_t    lift = {0};
+    nt_pipeline_init(&st, NULL);
+
+    uint32_t t = 0;
+    for (int i = 0; i < 8; i++, t += FRAME_MS) {
+        cgen6_report_t f = finger(3, 1000, 1000, t * 10);
+        nt_pipeline_process(&st, &f, TRACKPAD_INPUT_MODE_MOUSE, t, &out);
+        assert(!out.ptp_send && out.mouse_count == 0 && "a still finger moves nothing");
+    }
+    nt_pipeline_process(&st, &lift, TRACKPAD_INPUT_MODE_MOUSE, t, &out);
+    assert(out.mouse_count == 2 && out.mouse[0].buttons == BUTTON_PRIMARY && out.mouse[1].buttons == 0);
+
+    nt_pipeline_process(&st, &lift, TRACKPAD_INPUT_MODE_PTP, t += FRAME_MS, &out);
+    assert(out.mouse_count == 1 && out.mouse[0].buttons == 0 && "mode change releases the click");
+    assert(!out.ptp_send);
+}
+
+// 4. Mouse mode: a flick far faster than 127 counts a frame, then a lift. Every
+// count of the accelerated motion of the contact the PTP report carries (the
+// same corrected, smoothed stream) is reported, none over the report's range;
+// the overflow drains after the lift.
+static void test_mouse_flick(void) {
+    nt_pipeline_t     st;
+    nt_pipeline_out_t out;
+    nt_pipeline_init(&st, NULL);
+
+    uint32_t t = 0;
+    for (int i = 0; i < 8; i++, t += FRAME_MS) {  // settle: not a tap
+        cgen6_report_t f = finger(3, 300, 1000, t * 10);
+        nt_pipeline_process(&st, &f, TRACKPAD_INPUT_MODE_MOUSE, t, &out);
+    }
+    int32_t  owed_x = 0, owed_y = 0;
+    long     got_x = 0, got_y = 0;
+    uint16_t x = 300, px = ptp_x(&out), py = ptp_y(&out);
+    for (int i = 0; i < 4; i++, t += FRAME_MS) {
+        x += 400;
+        cgen6_report_t f = finger(3, x, 1000, t * 10);
+        nt_pipeline_process(&st, &f, TRACKPAD_INPUT_MODE_MOUSE, t, &out);
+        owed_x += nt_accel_q8(&mouse_accel, (int16_t)(ptp_x(&out) - px));
+        owed_y += nt_accel_q8(&mouse_accel, (int16_t)(ptp_y(&out) - py));
+        px = ptp_x(&out), py = ptp_y(&out);
+        for (uint8_t r = 0; r < out.mouse_count; r++) got_x += out.mouse[r].x, got_y += out.mouse[r].y;
+    }
+    cgen6_report_t lift   = {0};
+    int            drains = 0;
+    do {
+        nt_pipeline_process(&st, &lift, TRACKPAD_INPUT_MODE_MOUSE, t += FRAME_MS, &out);
+        for (uint8_t r = 0; r < out.mouse_count; r++) {
+            assert(out.mouse[r].buttons == 0 && "a flick is not a tap");
+            assert(abs(out.mouse[r].x) <= NT_MOUSE_XY_MAX && abs(out.mouse[r].y) <= NT_MOUSE_XY_MAX);
+            got_x += out.mouse[r].x, got_y += out.mouse[r].y;
+        }
+        drains++;
+    } while (nt_pipeline_pending(&st));
+    printf("  flick: %ld/%d counts reported, %d frame(s) to drain\n", got_x, owed_x / 256, drains);
+    assert(got_x == owed_x / 256 && got_y == owed_y / 256 && "no counts dropped");
+    assert(NT_MOUSE_XY_MAX == 127 && "core's fallback report is 8-bit");
+    assert(drains > 1 && "the overflow is carried");
+}
+
+// 5. Mouse mode follows a contact by host_id: the sensor swapping two fingers'
+// slots, and the followed finger lifting while the other stays down, move the
+// cursor no more than the fingers do.
+static void test_mouse_follows_contact(void) {
+    nt_pipeline_t     st;
+    nt_pipeline_out_t out;
+    nt_pipeline_init(&st, NULL);
+
+    uint32_t t = 0;
+    int      max_step = 0;
+    for (int i = 0; i < 60; i++, t += FRAME_MS) {
+        // Finger 3 drags right slowly next to a still finger 4; from frame 20
+        // the sensor lists them the other way round, from frame 40 finger 3 is
+        // up.
+        cgen6_report_t f = {.scan_time = t * 10, .contact_count = i < 40 ? 2 : 1};
+        cgen6_finger_t a = {.tip = 1, .confidence = 1, .id = 3, .x = 600 + i * 4, .y = 1000};
+        cgen6_finger_t b = {.tip = 1, .confidence = 1, .id = 4, .x = 1600, .y = 700};
+        if (i < 20) {
+            f.fingers[0] = a, f.fingers[1] = b;
+        } else if (i < 40) {
+            f.fingers[0] = b, f.fingers[1] = a;
+        } else {
+            f.fingers[0] = b;
+        }
+        nt_pipeline_process(&st, &f, TRACKPAD_INPUT_MODE_MOUSE, t, &out);
+        for (uint8_t r = 0; r < out.mouse_count; r++) {
+            int step = abs(out.mouse[r].x) + abs(out.mouse[r].y);
+            if (step > max_step) max_step = step;
+        }
+        if (i == 39) assert(st.mouse.host_id == 0 && "a slot swap keeps the followed contact");
+    }
+    printf("  slot swap and lift-off: largest step %d counts\n", max_step);
+    assert(max_step <= 3 && "the cursor must not jump between fingers");
+    assert(st.mouse.host_id == 1 && st.mouse.tracking);
+}
+
+// 6. Mouse mode reads smoothed positions: a finger resting with sensor jitter
+// after a drag moves the cursor less than the raw jitter would.
+static void test_mouse_jitter(void) {
+    nt_pipeline_t     st;
+    nt_pipeline_out_t out;
+    nt_pipeline_init(&st, NULL);
+
+    uint32_t t = 0;
+    for (int i = 0; i < 20; i++, t += FRAME_MS) {  // a drag, so motion is reported
+        cgen6_report_t f = finger(2, 700 + i * 15, 1000, t * 10);
+        nt_pipeline_process(&st, &f, TRACKPAD_INPUT_MODE_MOUSE, t, &out);
+    }
+    uint32_t rng = 1;
+    int32_t  raw = 0, prev = 0;
+    long     got = 0;
+    for (int i = 0; i < 2000 / FRAME_MS; i++, t += FRAME_MS) {
+        rng = rng * 1103515245u + 12345u;
+        int            j = (int)((rng >> 16) % 17) - 8;
+        cgen6_report_t f = finger(2, 985 + j, 1000, t * 10);
+        nt_pipeline_process(&st, &f, TRACKPAD_INPUT_MODE_MOUSE, t, &out);
+        for (uint8_t r = 0; r < out.mouse_count; r++) got += abs(out.mouse[r].x) + abs(out.mouse[r].y);
+        // The same jitter through the curve unfiltered, in logical units
+        if (i > 0) raw += abs(nt_accel_q8(&mouse_accel, (int16_t)(((j - prev) * SENSOR_SCALE_X_MULT) / 65536)));
+        prev = j;
+    }
+    printf("  resting finger, +/-8 sensor units of jitter: %ld counts of cursor motion (unfiltered %d)\n", got,
+           raw / 256);
+#if NAVIGATOR_TRACKPAD_PTP_SMOOTHING == TRUE
+    assert(got * 2 < raw / 256 && "smoothing must reach the fallback cursor");
+#endif
+}
+
+#if NAVIGATOR_TRACKPAD_SCROLL == TRUE
+// 7. Mouse mode, two fingers: the stroke scrolls by its travel, the cursor
+// holds still, and the lift is not a tap.
+static void test_mouse_scroll(void) {
+    nt_pipeline_t     st;
+    nt_pipeline_out_t out;
+    nt_pipeline_init(&st, NULL);
+
+    uint32_t t = 0;
+    long     v = 0, h = 0;
+    for (int i = 0; i < 40; i++, t += FRAME_MS) {
+        cgen6_report_t f = {.scan_time = t * 10, .contact_count = 2};
+        f.fingers[0]     = (cgen6_finger_t){.tip = 1, .confidence = 1, .id = 1, .x = 900, .y = 600 + i * 12};
+        f.fingers[1]     = (cgen6_finger_t){.tip = 1, .confidence = 1, .id = 2, .x = 1300, .y = 600 + i * 12};
+        nt_pipeline_process(&st, &f, TRACKPAD_INPUT_MODE_MOUSE, t, &out);
+        assert(out.mouse_count == 0 && "the cursor holds still while scrolling");
+        if (out.scroll) v += out.scroll_v, h += out.scroll_h;
+    }
+    cgen6_report_t lift = {0};
+    do {
+        nt_pipeline_process(&st, &lift, TRACKPAD_INPUT_MODE_MOUSE, t += FRAME_MS, &out);
+        assert(out.mouse_count == 0 && "a scroll is not a tap");
+        if (out.scroll) v += out.scroll_v, h += out.scroll_h;
+    } while (nt_pipeline_pending(&st));
+    printf("  two-finger scroll: %ld wheel, %ld pan counts at %d per notch\n", v, h,
+           NAVIGATOR_TRACKPAD_SCROLL_RESOLUTION);
+    // The smoothed centroid covers most of the 468 sensor units (~550 logical)
+    // by the lift; the sign follows NATURAL, the axis the rotation.
+    long travel = labs(v) + labs(h);
+    assert(travel * NAVIGATOR_TRACKPAD_SCROLL_UNITS_PER_NOTCH >= 400L * NAVIGATOR_TRACKPAD_SCROLL_RESOLUTION);
+    assert(travel * NAVIGATOR_TRACKPAD_SCROLL_UNITS_PER_NOTCH <= 560L * NAVIGATOR_TRACKPAD_SCROLL_RESOLUTION);
+}
+#endif
+
+// 8. A finger resting with sensor jitter, then moving off: repeats of the last
+// report are held back, but never for the keep-alive interval or longer, and
+// the move and the lift are sent the frame they happen. How many repeats there
+// are depends on the jitter left after smoothing; a quiet pad rests silently.
+static int rest(nt_pipeline_t *st, int jitter, uint32_t *t) {
+    nt_pipeline_out_t out;
+    uint32_t          rng = 1, last_sent = 0, max_gap = 0;
+    int               sent = 0, frames = 2000 / FRAME_MS;
+    for (int i = 0; i < frames; i++, *t += FRAME_MS) {
+        rng              = rng * 1103515245u + 12345u;
+        int            j = (int)((rng >> 16) % (2 * jitter + 1)) - jitter;
+        cgen6_report_t f = finger(2, 1000 + j, 1000 - j, *t * 10);
+        nt_pipeline_process(st, &f, TRACKPAD_INPUT_MODE_PTP, *t, &out);
+        assert(out.active && out.ptp_send != out.ptp_suppressed);
+        if (out.ptp_send) {
+            if (sent) max_gap = *t - last_sent > max_gap ? *t - last_sent : max_gap;
+            sent++;
+            last_sent = *t;
+        }
+    }
+    printf("  resting finger, +/-%d sensor units of jitter: %d of %d frames reported, longest gap %u ms\n", jitter,
+           sent, frames, max_gap);
+#if NAVIGATOR_TRACKPAD_PTP_SUPPRESS_STATIONARY == TRUE
+    assert(max_gap < NAVIGATOR_TRACKPAD_PTP_KEEPALIVE_MS + FRAME_MS && "keep-alive missed");
+#else
+    assert(sent == frames);
+#endif
+    return sent * 100 / frames;
+}
+
+static void test_rest_suppression(void) {
+    nt_pipeline_t     st;
+    nt_pipeline_out_t out;
+    uint32_t          t = 0;
+    nt_pipeline_init(&st, NULL);
+
+    int quiet = rest(&st, 2, &t);
+    rest(&st, 8, &t);
+#if NAVIGATOR_TRACKPAD_PTP_SUPPRESS_STATIONARY == TRUE && NAVIGATOR_TRACKPAD_PTP_SMOOTHING == TRUE
+    assert(quiet < 50 && "a quiet resting finger must not be reported every frame");
+#else
+    (void)quiet;
+#endif
+
+    for (int i = 1; i <= 3; i++, t += FRAME_MS) {
+        cgen6_report_t f = finger(2, 1000 + i * 60, 1000, t * 10);
+        nt_pipeline_process(&st, &f, TRACKPAD_INPUT_MODE_PTP, t, &out);
+        assert(out.ptp_send && "a move is sent at once");
+    }
+    cgen6_report_t lift = {0};
+    nt_pipeline_process(&st, &lift, TRACKPAD_INPUT_MODE_PTP, t, &out);
+    assert(out.ptp_send && !ptp_tip(&out));
+}
+
+// 9. Throughput on the host.
+static void test_throughput(void) {
+    nt_pipeline_t     st;
+    nt_pipeline_out_t out;
+    nt_pipeline_init(&st, NULL);
+    const int       frames = 2000000;
+    uint32_t        sent   = 0;
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (int i = 0; i < frames; i++) {
+        run_trace(&st, i / 3000 % 2, i, &out);
+        sent += out.ptp_send;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double secs = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+    printf("  %d frames in %.3f s: %.1f M frames/s (%u reports)\n", frames, secs, frames / secs / 1e6, sent);
+    assert(sent > 0);
+}
+
+int main(void) {
+    test_swipe();
+    test_state_is_explicit();
+    test_mouse_tap();
+    test_mouse_flick();
+    test_mouse_follows_contact();
+    test_mouse_jitter();
+#if NAVIGATOR_TRACKPAD_SCROLL == TRUE
+    test_mouse_scroll();
+#endif
+    test_rest_suppression();
+    test_throughput();
+    printf("All pipeline tests passed\n");
+    return 0;
+}
@@ -0,0 +1,268 @@
+// Copyright 2026 ZSA Technology Labs, Inc <contact@zsa.io>
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// Host benchmark for the PTP motion predictor, run after the One Euro filter
+// exactly as in navigator_trackpad_pipeline.c.
+// Build & run from the module root:
+//   gcc -Wall -o /tmp/nt_predict_test navigator_trackpad/tests/predict_test.c -lm
+//   /tmp/nt_predict_test [recording.txt]
+//
+// Each trace is a finger path sampled every 8 ms with sensor jitter. A report
+// built from the sample at t reaches the screen at t + LATENCY_MS, so the
+// error that matters is the distance from the output to the finger at that
+// later time. For horizons from 0 (no prediction) up, prints:
+//   lag        mean error while the finger moves
+//   overshoot  furthest the output goes beyond the path (flick stop, zigzag
+//              turns, circle)
+//   rest       mean deviation of a resting finger (jitter)
+// and checks that the default horizon cuts the lag substantially without
+// overshooting or adding jitter.
+//
+// A recording ("scan_time x y" per line, scan_time in 100 us, blank line on
+// lift) can be passed to get the same figures on real data; with no ground
+// truth there, the reference is the recording itself LATENCY_MS later.
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../navigator_trackpad_filter.h"
+#include "../navigator_trackpad_predict.h"
+
+// Matches the defaults in navigator_trackpad_pipeline.h.
+#define MINCUTOFF 1.5f
+#define BETA 0.0070f
+#define DCUTOFF 15.0f
+#define PREDICT_ALPHA 0.5f
+#define PREDICT_BETA 0.15f
+#define PREDICT_VMIN 400
+#define PREDICT_MAX_LEAD 64
+#define HORIZON_MS 8
+
+#define FRAME_TICKS 80   // 8 ms sensor frame
+#define LATENCY_MS 12    // sample to screen: half a frame, poll, USB, host
+#define NOISE 4.0        // +/- units of sensor jitter
+#define MOVING 300.0     // units/s above which a frame counts toward lag
+
+static nt_predict_cfg_t cfg_for(int horizon_ms) {
+    return (nt_predict_cfg_t){NT_PREDICT_Q8(PREDICT_ALPHA), NT_PREDICT_Q8(PREDICT_BETA), horizon_ms * 10,
+                              PREDICT_VMIN * 16, PREDICT_MAX_LEAD};
+}
+
+// Deterministic pseudo-noise in [-amp, amp].
+static double pseudo_noise(int i, double amp) {
+    double s = sin(i * 12.9898) * 43758.5453;
+    s -= floor(s);
+    return (s * 2 - 1) * amp;
+}
+
+// --- Synthetic traces (logical units, t in seconds) ---------------------------
+enum { FLICK, RAMP, ZIGZAG, CIRCLE, REST, TRACES };
+static const char *const trace_name[TRACES] = {"flick", "ramp", "zigzag", "circle", "rest"};
+static const double      trace_len[TRACES]  = {0.5, 0.25, 1.0, 1.5, 1.0};
+
+static void truth(int kind, double t, double *x, double *y) {
+    switch (kind) {
+        case FLICK: {  // 300 -> 1700 in 160 ms (smoothstep), then held still
+            double u = t < 0.16 ? t / 0.16 : 1;
+            *x       = 300 + 1400 * u * u * (3 - 2 * u);
+            *y       = 900 + 200 * u * u * (3 - 2 * u);
+            break;
+        }
+        case RAMP:  // 6000 units/s diagonal
+            *x = 200 + 6000 * t * 0.8;
+            *y = 200 + 6000 * t * 0.6;
+            break;
+        case ZIGZAG: {  // triangle wave, +/-400 units, 4 turns per second
+            double ph = fmod(t * 2, 1);
+            *x        = 1024 + 400 * (ph < 0.5 ? ph * 4 - 1 : 3 - ph * 4);
+            *y        = 1024 + 100 * t;
+            break;
+        }
+        case CIRCLE:  // r 500, 1.5 turns per second
+            *x = 1024 + 500 * cos(t * 1.5 * 2 * M_PI);
+            *y = 1024 + 500 * sin(t * 1.5 * 2 * M_PI);
+            break;
+        default:
+            *x = 1024;
+            *y = 1024;
+    }
+}
+
+typedef struct {
+    double lag;        // mean error while moving, units
+    double overshoot;  // furthest beyond the path's extent, units
+    double rest;       // mean deviation when the path is still, units
+} metrics_t;
+
+// Filter (+ predict) a sampled path and score it against `ref`, the position
+// LATENCY_MS after each sample.
+// A sample with `lift` set starts a new contact.
+static metrics_t run(const double *sx, const double *sy, const double *rx, const double *ry, const double *speed,
+                     const bool *lift, int n, int horizon_ms, const double box[4]) {
+    nt_euro_point_t    f   = {0};
+    nt_predict_point_t p   = {0};
+    nt_predict_cfg_t   cfg = cfg_for(horizon_ms);
+    metrics_t          m   = {0};
+    int                moving = 0, still = 0;
+    for (int i = 0; i < n; i++) {
+        if (lift[i]) {
+            nt_euro_point_reset(&f);
+            nt_predict_point_reset(&p);
+        }
+        float fx = (float)sx[i], fy = (float)sy[i];
+        nt_euro_point_filter(&f, &fx, &fy, FRAME_TICKS * 0.0001f, MINCUTOFF, BETA, DCUTOFF);
+        int32_t x = (int32_t)(fx + 0.5f), y = (int32_t)(fy + 0.5f);
+        if (horizon_ms > 0) nt_predict_point(&p, &x, &y, FRAME_TICKS, &cfg);
+
+        double e = hypot(x - rx[i], y - ry[i]);
+        if (speed[i] > MOVING) {
+            m.lag += e;
+            moving++;
+        } else if (i > 10 && !lift[i]) {
+            m.rest += e;
+            still++;
+        }
+        double over = fmax(fmax(box[0] - x, x - box[1]), fmax(box[2] - y, y - box[3]));
+        if (over > m.overshoot) m.overshoot = over;
+    }
+    m.lag  = moving ? m.lag / moving : 0;
+    m.rest = still ? m.rest / still : 0;
+    return m;
+}
+
+#define MAX_FRAMES 4096
+static double sx[MAX_FRAMES], sy[MAX_FRAMES], rx[MAX_FRAMES], ry[MAX_FRAMES], spd[MAX_FRAMES];
+static bool   lift[MAX_FRAMES] = {true};
+
+static metrics_t run_trace(int kind, int horizon_ms) {
+    int    n      = (int)(trace_len[kind] / 0.008);
+    double box[4] = {1e9, -1e9, 1e9, -1e9};
+    for (int i = 0; i < n; i++) {
+        double t = i * 0.008, x, y, x1, y1;
+        truth(kind, t, &x, &y);
+        sx[i] = x + pseudo_noise(i + kind * 1000, NOISE);
+        sy[i] = y + pseudo_noise(i + kind * 1000 + 500, NOISE);
+        truth(kind, t + LATENCY_MS / 1000.0, &rx[i], &ry[i]);
+        truth(kind, t + 0.001, &x1, &y1);
+        spd[i] = hypot(x1 - x, y1 - y) * 1000;
+        box[0] = fmin(box[0], fmin(x, rx[i])), box[1] = fmax(box[1], fmax(x, rx[i]));
+        box[2] = fmin(box[2], fmin(y, ry[i])), box[3] = fmax(box[3], fmax(y, ry[i]));
+    }
+    return run(sx, sy, rx, ry, spd, lift, n, horizon_ms, box);
+}
+
+static const int horizons[] = {0, 4, 8, 12, 16};
+#define HORIZONS (int)(sizeof(horizons) / sizeof(horizons[0]))
+
+// 1. Lag versus overshoot across horizons, on each synthetic trace.
+static void test_lag_vs_overshoot(void) {
+    metrics_t m[TRACES][HORIZONS];
+    printf("  horizon          ");
+    for (int h = 0; h < HORIZONS; h++) printf("%8d ms", horizons[h]);
+    printf("\n");
+    for (int k = 0; k < TRACES; k++) {
+        printf("  %-6s %s", trace_name[k], k == REST ? "rest      " : "lag / over");
+        for (int h = 0; h < HORIZONS; h++) {
+            m[k][h] = run_trace(k, horizons[h]);
+            if (k == REST) {
+                printf("  %9.1f", m[k][h].rest);
+            } else {
+                printf("  %5.1f/%-3.0f", m[k][h].lag, m[k][h].overshoot);
+            }
+        }
+        printf("\n");
+    }
+    fflush(stdout);
+
+    int d = 2;  // HORIZON_MS
+    assert(horizons[d] == HORIZON_MS);
+    assert(m[RAMP][d].lag < m[RAMP][0].lag * 0.7 && "prediction must cut the lag on a steady stroke");
+    assert(m[FLICK][d].lag < m[FLICK][0].lag * 0.75);
+    assert(m[CIRCLE][d].lag < m[CIRCLE][0].lag * 0.75);
+    assert(m[FLICK][d].overshoot < 10 && "a flick must stop where the finger stops");
+    assert(m[ZIGZAG][d].overshoot < 15 && "a reversal must not sail past the turn");
+    assert(m[REST][d].rest < m[REST][0].rest * 1.1 + 0.1 && "a resting finger must not pick up jitter");
+}
+
+// 2. The lead is capped, and seeding/reset start a contact without a lead.
+static void test_clamps(void) {
+    nt_predict_cfg_t   cfg = cfg_for(50);
+    nt_predict_point_t p   = {0};
+    int32_t            x = 100, y = 100;
+    nt_predict_point(&p, &x, &y, FRAME_TICKS, &cfg);
+    assert(x == 100 && y == 100 && "first sample must seed without a lead");
+    for (int i = 1; i < 20; i++) {
+        x = 100 + 200 * i, y = 100;
+        nt_predict_point(&p, &x, &y, FRAME_TICKS, &cfg);
+    }
+    assert(x - (100 + 200 * 19) == PREDICT_MAX_LEAD && "the lead is capped");
+    assert(y == 100);
+
+    // Reversal drops the velocity at once.
+    x = 100 + 200 * 18, y = 100;
+    nt_predict_point(&p, &x, &y, FRAME_TICKS, &cfg);
+    assert(x <= 100 + 200 * 18 && "no lead past a reversal");
+
+    nt_predict_point_reset(&p);
+    x = 500, y = 600;
+    nt_predict_point(&p, &x, &y, FRAME_TICKS, &cfg);
+    assert(x == 500 && y == 600 && "reset then first sample must seed exactly");
+}
+
+// A recording: "scan_time x y" lines, blank line between contacts.
+static void bench_recording(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        perror(path);
+        exit(1);
+    }
+    static double t[MAX_FRAMES];
+    char          line[128];
+    int           n = 0;
+    bool          down = false;
+    double        base = 0, prev = -1;
+    while (fgets(line, sizeof line, f) && n < MAX_FRAMES) {
+        unsigned scan;
+        double   x, y;
+        if (sscanf(line, "%u %lf %lf", &scan, &x, &y) != 3) {
+            if (line[0] == '\n' || line[0] == '\r') down = false;
+            continue;
+        }
+        double ts = scan / 10000.0;
+        while (prev >= 0 && ts + base < prev) base += 6.5536;  // scan_time wrap
+        prev    = ts + base;
+        t[n]    = prev, sx[n] = x, sy[n] = y;
+        lift[n] = !down;
+        down    = true;
+        n++;
+    }
+    fclose(f);
+    double box[4] = {1e9, -1e9, 1e9, -1e9};
+    for (int i = 0, j = 0; i < n; i++) {
+        // Reference: the same contact LATENCY_MS later (interpolated).
+        double target = t[i] + LATENCY_MS / 1000.0;
+        if (j < i) j = i;
+        while (j + 1 < n && !lift[j + 1] && t[j + 1] < target) j++;
+        bool   next = j + 1 < n && !lift[j + 1] && t[j + 1] > t[j];
+        double u    = next ? fmin(1, fmax(0, (target - t[j]) / (t[j + 1] - t[j]))) : 0;
+        rx[i]       = sx[j] + (next ? (sx[j + 1] - sx[j]) * u : 0);
+        ry[i]       = sy[j] + (next ? (sy[j + 1] - sy[j]) * u : 0);
+        spd[i]      = lift[i] ? 0 : hypot(sx[i] - sx[i - 1], sy[i] - sy[i - 1]) / fmax(t[i] - t[i - 1], 0.001);
+        box[0] = fmin(box[0], sx[i]), box[1] = fmax(box[1], sx[i]);
+        box[2] = fmin(box[2], sy[i]), box[3] = fmax(box[3], sy[i]);
+    }
+    printf("  %s: %d samples\n", path, n);
+    for (int h = 0; h < HORIZONS; h++) {
+        metrics_t m = run(sx, sy, rx, ry, spd, lift, n, horizons[h], box);
+        printf("    %2d ms: lag %5.1f  over %4.1f  rest %4.1f units\n", horizons[h], m.lag, m.overshoot, m.rest);
+    }
+}
+
+int main(int argc, char **argv) {
+    test_clamps();
+    test_lag_vs_overshoot();
+    if (argc > 1) bench_recording(argv[1]);
+    printf("All predictor tests passed\n");
+    return 0;
+}
@@ -0,0 +1,149 @@
+// Copyright 2026 ZSA Technology Labs, Inc <contact@zsa.io>
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// Host test for the per-stage task timing (navigator_trackpad_profile.h),
+// built in with the mock bus's microsecond clock as the time source.
+// Build & run from the module root:
+//   gcc -Wall -Inavigator_trackpad/tests/host -o /tmp/nt_profile_test navigator_trackpad/tests/profile_test.c -lm
+//   /tmp/nt_profile_test
+//
+// Checks the counters and histogram binning on their own, then runs the PTP
+// task against the Gen6 simulator with a finger on the pad: every frame must
+// be charged to each stage once, the read stage must see exactly the modelled
+// bus time of the report reads, and the stages that do no I/O none at all (the fake clock only moves
+// on the bus). Also checks the dump and raw HID packing.
+
+#define NAVIGATOR_TRACKPAD_PROFILE TRUE
+#define NT_PROFILE_NOW() fake_clock()
+#define NT_PROFILE_UNIT "us"
+#include <stdint.h>
+static uint32_t fake_clock(void);
+
+#include "../navigator_trackpad_common.c"
+#include "../navigator_trackpad_pipeline.c"
+#include "../navigator_trackpad_ptp.c"
+#include "host/cgen6_sim.h"
+
+#define LOOP_US 100
+
+static uint32_t fake_clock(void) {
+    return (uint32_t)mock_clock_us;
+}
+
+// --- Host side ---------------------------------------------------------------
+static uint32_t ptp_sends;
+
+void send_digitizer_touchpad(report_digitizer_touchpad_t *report) {
+    (void)report;
+    ptp_sends++;
+}
+
+void send_digitizer_touchpad_mouse(report_digitizer_touchpad_mouse_t *report) {
+    (void)report;
+}
+
+uint8_t digitizer_touchpad_get_input_mode(void) {
+    return TRACKPAD_INPUT_MODE_PTP;
+}
+
+static void run(uint64_t us) {
+    uint64_t end = mock_clock_us + us;
+    while (mock_clock_us < end) {
+        cgen6_sim_update();
+        navigator_trackpad_ptp_task();
+        mock_clock_advance_us(LOOP_US);
+    }
+}
+
+// 1. Counters and base-4 bins.
+static void test_record(void) {
+    assert(nt_profile_bin(0) == 0);
+    assert(nt_profile_bin(1) == 1 && nt_profile_bin(3) == 1);
+    assert(nt_profile_bin(4) == 2 && nt_profile_bin(15) == 2);
+    assert(nt_profile_bin(16) == 3 && nt_profile_bin(1023) == 5 && nt_profile_bin(1024) == 6);
+    assert(nt_profile_bin(UINT32_MAX) == NT_PROFILE_BINS - 1);
+
+    nt_profile_stat_t s = {0};
+    assert(nt_profile_mean(&s) == 0);
+    nt_profile_record(&s, 10);
+    nt_profile_record(&s, 30);
+    nt_profile_record(&s, 2);
+    assert(s.count == 3 && s.min == 2 && s.max == 30 && nt_profile_mean(&s) == 14);
+    assert(s.hist[1] == 1 && s.hist[2] == 1 && s.hist[3] == 1);
+
+    s.hist[0] = UINT16_MAX;
+    nt_profile_record(&s, 0);
+    assert(s.hist[0] == UINT16_MAX && "bins saturate instead of wrapping");
+}
+
+// 2. One stage sample per frame, with the read charged the bus time.
+static void test_task_stages(void) {
+    static const cgen6_sim_key_t hold[] = {
+        {.t_ms = 0, .count = 1, .fingers = {{.id = 3, .x = 800, .y = 1000}}},
+        {.t_ms = 2000, .count = 1, .fingers = {{.id = 3, .x = 1200, .y = 1000}}},
+    };
+    cgen6_sim_reset();
+    cgen6_sim.resend_partial = NAVIGATOR_TRACKPAD_LENGTH_PREFIXED_READS == TRUE;
+    mock_clock_advance_ms(100);
+    navigator_trackpad_init_start();
+    run(100000);
+    assert(trackpad_init);
+    cgen6_sim_play(hold, 2);
+    run(100000);  // settle into streaming
+
+    navigator_trackpad_profile_clear();
+    mock_bus_stats_t bus    = mock_bus_stats;
+    uint32_t         frames = cgen6_sim.stats.frames_read;
+    ptp_sends               = 0;
+    run(1000000);
+    uint32_t xfers  = mock_bus_stats.transactions - bus.transactions;
+    uint64_t bus_us = mock_bus_stats.bus_us - bus.bus_us;
+    frames          = cgen6_sim.stats.frames_read - frames;
+
+    const nt_profile_stat_t *read   = navigator_trackpad_profile_get(NT_STAGE_READ);
+    const nt_profile_stat_t *decode = navigator_trackpad_profile_get(NT_STAGE_DECODE);
+    const nt_profile_stat_t *frame  = navigator_trackpad_profile_get(NT_STAGE_FRAME);
+    printf("  %u frames, %u reads (%u bus transactions): read %u/%u/%u us (min/mean/max), modelled bus time %.1f us per read\n",
+           frames, read->count, xfers, read->min, nt_profile_mean(read), read->max, (double)bus_us / read->count);
+    navigator_trackpad_profile_dump();
+
+    // Every transaction is one read (a length header and the report after it
+    // are two).
+    assert(read->count >= decode->count && read->count == xfers);
+    assert(read->sum == bus_us && "the read stage is the bus transfer");
+    assert(decode->count >= frames && frame->count == decode->count);
+    for (uint8_t st = NT_STAGE_TRANSFORM; st <= NT_STAGE_SEND; st++) {
+        const nt_profile_stat_t *s = navigator_trackpad_profile_get(st);
+        assert(s->count == frame->count && "every stage runs once per frame");
+        assert(s->max == 0 && s->hist[0] == s->count && "no I/O, so no fake time");
+    }
+    assert(ptp_sends == frame->count);
+    assert(navigator_trackpad_profile_get(NT_STAGE_COUNT) == NULL);
+}
+
+// 3. Raw HID packing of one stage.
+static void test_pack(void) {
+    uint8_t buf[32];
+    assert(navigator_trackpad_profile_pack(NT_STAGE_COUNT, buf, sizeof(buf)) == 0);
+    assert(navigator_trackpad_profile_pack(NT_STAGE_READ, buf, NT_PROFILE_PACK_SIZE - 1) == 0);
+    assert(navigator_trackpad_profile_pack(NT_STAGE_READ, buf, sizeof(buf)) == NT_PROFILE_PACK_SIZE);
+
+    const nt_profile_stat_t *read = navigator_trackpad_profile_get(NT_STAGE_READ);
+    assert(buf[0] == NT_STAGE_READ);
+    assert((uint32_t)(buf[1] | buf[2] << 8 | buf[3] << 16 | (uint32_t)buf[4] << 24) == read->count);
+    assert((uint32_t)(buf[13] | buf[14] << 8 | buf[15] << 16 | (uint32_t)buf[16] << 24) == read->max);
+    uint32_t share = 0;
+    for (uint8_t b = 0; b < NT_PROFILE_BINS; b++) share += buf[17 + b];
+    assert(share >= 250 && share <= 260);
+
+    navigator_trackpad_profile_clear();
+    assert(navigator_trackpad_profile_get(NT_STAGE_READ)->count == 0);
+}
+
+int main(void) {
+    test_record();
+    test_task_stages();
+    test_pack();
+    printf("All profile tests passed\n");
+    return 0;
+}
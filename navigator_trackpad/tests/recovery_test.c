@@ -0,0 +1,170 @@
+// Copyright 2026 ZSA Technology Labs, Inc <contact@zsa.io>
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// Host test for graded I2C fault recovery and the error counters, running the
+// full PTP task against the Gen6 simulator with a finger held on the pad.
+// Build & run from the module root:
+//   gcc -Wall -Inavigator_trackpad/tests/host -o /tmp/nt_recovery_test navigator_trackpad/tests/recovery_test.c -lm
+//   /tmp/nt_recovery_test
+//
+// Verifies that a one-transfer glitch costs one retried read instead of a
+// probe interval, that a short burst is absorbed by a bus re-sync within a few
+// milliseconds, that an unplugged pad is probed on an exponential backoff
+// capped at the slow probe interval, and that every fault class is counted.
+// The report gap stands in for the read cadence, so every frame is sent.
+
+#define NAVIGATOR_TRACKPAD_PTP_SUPPRESS_STATIONARY FALSE
+
+#include "../navigator_trackpad_common.c"
+#include "../navigator_trackpad_pipeline.c"
+#include "../navigator_trackpad_ptp.c"
+#include "host/cgen6_sim.h"
+
+#define LOOP_US 100
+
+// --- Host side ---------------------------------------------------------------
+static uint32_t ptp_sends;
+static uint64_t last_send_us, max_send_gap_us;
+
+void send_digitizer_touchpad(report_digitizer_touchpad_t *report) {
+    (void)report;
+    if (ptp_sends && mock_clock_us - last_send_us > max_send_gap_us) {
+        max_send_gap_us = mock_clock_us - last_send_us;
+    }
+    ptp_sends++;
+    last_send_us = mock_clock_us;
+}
+
+void send_digitizer_touchpad_mouse(report_digitizer_touchpad_mouse_t *report) {
+    (void)report;
+}
+
+uint8_t digitizer_touchpad_get_input_mode(void) {
+    return TRACKPAD_INPUT_MODE_PTP;
+}
+
+// --- Sensor: the Gen6 simulator with a finger held on the pad, drifting right --
+static const cgen6_sim_key_t hold[] = {
+    {.t_ms = 0, .count = 1, .fingers = {{.id = 4, .x = 800, .y = 1000}}},
+    {.t_ms = 60000, .count = 1, .fingers = {{.id = 4, .x = 1200, .y = 1000}}},
+};
+static uint32_t pings_at[64];
+static uint8_t  pings;
+
+// Wrap the ping shim's bookkeeping: mock_bus_begin(0) is a ping.
+static void run(uint64_t us) {
+    uint64_t end = mock_clock_us + us;
+    while (mock_clock_us < end) {
+        uint32_t before = mock_bus_stats.transactions;
+        uint64_t bytes  = mock_bus_stats.bytes;
+        cgen6_sim_update();
+        navigator_trackpad_ptp_task();
+        // A transaction with no bytes on the wire is an address ping.
+        if (mock_bus_stats.transactions == before + 1 && mock_bus_stats.bytes == bytes && pings < 64) {
+            pings_at[pings++] = timer_read32();
+        }
+        mock_clock_advance_us(LOOP_US);
+    }
+}
+
+static void setup(void) {
+    cgen6_sim_reset();
+    cgen6_sim.resend_partial = NAVIGATOR_TRACKPAD_LENGTH_PREFIXED_READS == TRUE;
+    mock_clock_advance_ms(100);
+    cgen6_sim_play(hold, 2);
+    navigator_trackpad_device_init();
+    assert(trackpad_init);
+    navigator_trackpad_clear_error_stats();
+    ptp_sends = 0;
+    max_send_gap_us = 0;
+    pings = 0;
+    run(100000);  // settle into streaming
+    max_send_gap_us = 0;
+}
+
+// 1. One failed transfer: retried at once, no visible freeze.
+static void test_single_glitch(void) {
+    setup();
+    mock_bus_inject_fault(I2C_STATUS_ERROR, 1);
+    run(200000);
+    const navigator_trackpad_error_stats_t *st = navigator_trackpad_get_error_stats();
+    printf("  single glitch: max report gap %llu us, nacks %u retries %u resyncs %u recoveries %u\n",
+           (unsigned long long)max_send_gap_us, st->nacks, st->retries, st->resyncs, st->recoveries);
+    assert(trackpad_init);
+    assert(st->nacks == 1 && st->retries == 1 && st->resyncs == 0 && st->recoveries == 1);
+    assert(max_send_gap_us <= 2 * NAVIGATOR_TRACKPAD_POLL_INTERVAL_MS * 1000 && "glitch must not freeze the cursor");
+}
+
+// 2. Two failures in a row: the retry fails too, a re-sync brings it back
+//    within a few milliseconds without the full drain/settle.
+static void test_short_burst_resyncs(void) {
+    setup();
+    mock_bus_inject_fault(I2C_STATUS_TIMEOUT, 2);
+    run(200000);
+    const navigator_trackpad_error_stats_t *st = navigator_trackpad_get_error_stats();
+    printf("  2-transfer burst: max report gap %llu us, timeouts %u retries %u resyncs %u recoveries %u\n",
+           (unsigned long long)max_send_gap_us, st->timeouts, st->retries, st->resyncs, st->recoveries);
+    assert(trackpad_init);
+    assert(st->timeouts == 2 && st->retries == 1 && st->resyncs == 1 && st->recoveries == 1);
+    assert(max_send_gap_us < 15000 && "a re-sync must recover in a few ms, not a probe interval");
+}
+
+// 3. Checksum failure while re-syncing is counted and escalates to a re-init.
+static void test_checksum_counted(void) {
+    setup();
+    mock_bus_inject_fault(I2C_STATUS_ERROR, 2);
+    cgen6_sim.fault.corrupt_cksum = 1;
+    run(300000);
+    const navigator_trackpad_error_stats_t *st = navigator_trackpad_get_error_stats();
+    printf("  burst + bad checksum: cksum failures %u, resyncs %u, recoveries %u\n", st->cksum_failures,
+           st->resyncs, st->recoveries);
+    assert(trackpad_init);
+    assert(st->cksum_failures == 1 && st->recoveries == 1);
+}
+
+// 4. A NACKed register read is counted as a NACK only: its stale buffer is
+//    not checked for a checksum or length.
+static void test_nacked_read_counted_once(void) {
+    setup();
+    uint8_t v;
+    mock_bus_inject_fault(I2C_STATUS_ERROR, 1);
+    assert(cirque_gen6_read_memory(CGEN6_FEED_CONFIG4, &v, 1, false) == CGEN6_I2C_FAILED);
+    const navigator_trackpad_error_stats_t *st = navigator_trackpad_get_error_stats();
+    assert(st->nacks == 1 && st->cksum_failures == 0 && st->len_mismatches == 0);
+    run(200000);
+    assert(trackpad_init);
+}
+
+// 5. Unplugged: probes back off exponentially to the slow probe interval, and
+//    the pad returns once plugged back in.
+static void test_unplug_backoff(void) {
+    setup();
+    mock_bus_present = false;
+    run(5000000);
+    assert(!trackpad_init);
+    printf("  unplugged 5 s: %u probes, intervals (ms):", pings);
+    uint32_t prev_gap = 0;
+    for (uint8_t i = 1; i < pings; i++) {
+        uint32_t gap = pings_at[i] - pings_at[i - 1];
+        printf(" %u", gap);
+        assert(gap + 1 >= prev_gap && "backoff must not shrink");
+        assert(gap <= NAVIGATOR_TRACKPAD_PROBE_INTERVAL_MS + 1 && "backoff must cap at the probe interval");
+        prev_gap = gap;
+    }
+    printf("\n");
+    assert(prev_gap + 1 >= NAVIGATOR_TRACKPAD_PROBE_INTERVAL_MS);
+
+    mock_bus_present = true;
+    run(NAVIGATOR_TRACKPAD_PROBE_INTERVAL_MS * 1000 + 200000);
+    assert(trackpad_init && navigator_trackpad_get_error_stats()->recoveries == 1);
+}
+
+int main(void) {
+    test_single_glitch();
+    test_short_burst_resyncs();
+    test_checksum_counted();
+    test_nacked_read_counted_once();
+    test_unplug_backoff();
+    printf("All recovery tests passed\n");
+    return 0;
+}
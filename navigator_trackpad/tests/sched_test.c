@@ -0,0 +1,126 @@
+// Copyright 2026 ZSA Technology Labs, Inc <contact@zsa.io>
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// Standalone host test for the adaptive poll scheduler.
+// Build & run from the module root:
+//   gcc -Wall -o /tmp/nt_sched_test navigator_trackpad/tests/sched_test.c
+//   /tmp/nt_sched_test
+//
+// Models a sensor producing a frame every period while touched (a
+// one-frame buffer, overwritten if not read in time) and a main loop with a
+// millisecond timer, then compares the scheduler against fixed 5 ms polling:
+//   1. While touching it locks on, delivering every frame with less delay and
+//      fewer polls.
+//   2. It stays locked through scan_time wraparound and a non-integer period.
+//   3. While idle it backs off to the deep tier.
+//   4. It snaps back on the first frame after a long idle; the touch-down
+//      delay is then bounded by the deepest idle tier.
+
+#include <assert.h>
+#include <stdio.h>
+#include "../navigator_trackpad_sched.h"
+
+#define TICK_US 100
+
+typedef struct {
+    uint32_t polls, empty, frames, delivered, lost;
+    uint64_t latency_sum, latency_max;
+    uint64_t first_us;  // touch-down to first frame delivered
+} run_stats_t;
+
+// Touch from touch_us to lift_us (us), run until end_us. Frames are produced
+// every period_us from touch_us with scan_time counting in 100 us units.
+static run_stats_t run(bool adaptive, uint32_t period_us, uint64_t touch_us, uint64_t lift_us, uint64_t end_us,
+                       uint16_t scan0) {
+    nt_sched_t s;
+    nt_sched_init(&s);
+    run_stats_t st = {0};
+
+    bool     pending = false, tracking = false;
+    uint64_t made_at = 0, next_frame = touch_us;
+    uint32_t last_poll_ms = 0;
+    for (uint64_t t = 0; t < end_us; t += TICK_US) {
+        if (t >= next_frame && t < lift_us) {
+            if (pending && st.delivered) st.lost++;
+            pending = true;
+            made_at = t;
+            st.frames++;
+            next_frame += period_us;
+        }
+        uint32_t ms       = (uint32_t)(t / 1000);
+        uint16_t interval = adaptive ? nt_sched_interval(&s) : NT_SCHED_BASE_MS;
+        if (ms - last_poll_ms < interval) {
+            continue;
+        }
+        last_poll_ms = ms;
+        st.polls++;
+        if (pending) {
+            pending = false;
+            if (!st.delivered++) st.first_us = t - touch_us;
+            uint64_t lat = t - made_at;
+            st.latency_sum += lat;
+            if (lat > st.latency_max) st.latency_max = lat;
+            tracking = true;
+            nt_sched_frame(&s, (uint16_t)(scan0 + (made_at - touch_us) / 100));
+        } else {
+            st.empty++;
+            if (t >= lift_us) tracking = false;  // lift-off seen: host released
+            nt_sched_empty(&s, tracking);
+        }
+    }
+    return st;
+}
+
+static void print_stats(const char *name, const run_stats_t *st, double seconds) {
+    printf("  %-22s %5.0f polls/s, %4.0f empty/s, %u/%u frames, latency mean %.2f ms max %.2f ms\n", name,
+           st->polls / seconds, st->empty / seconds, st->delivered, st->frames,
+           st->delivered ? st->latency_sum / 1000.0 / st->delivered : 0.0, st->latency_max / 1000.0);
+}
+
+// 1. A 2 s stroke at 8 ms: every frame, lower latency, fewer polls.
+static void test_locks_on(void) {
+    run_stats_t fixed = run(false, 8000, 3300, 2003300, 2003300, 0);
+    run_stats_t adapt = run(true, 8000, 3300, 2003300, 2003300, 0);
+    print_stats("touching, fixed 5 ms:", &fixed, 2.0);
+    print_stats("touching, adaptive:", &adapt, 2.0);
+    assert(adapt.lost == 0 && adapt.delivered == adapt.frames);
+    assert(adapt.polls < fixed.polls);
+    assert(adapt.latency_sum / adapt.delivered < fixed.latency_sum / fixed.delivered);
+    assert(adapt.latency_sum / adapt.delivered < 1500);
+}
+
+// 2. A period that is not a whole number of ms, with scan_time wrapping.
+static void test_fractional_period_and_wrap(void) {
+    run_stats_t st = run(true, 8300, 1000, 3001000, 3001000, 65000);
+    print_stats("8.3 ms, scan wraps:", &st, 3.0);
+    assert(st.lost == 0);
+    assert(st.latency_sum / st.delivered < 1500);
+}
+
+// 3. Ten idle seconds: the deep tier, a fraction of the fixed-rate polls.
+static void test_idle_backoff(void) {
+    run_stats_t fixed = run(false, 8000, 0, 0, 10000000, 0);
+    run_stats_t adapt = run(true, 8000, 0, 0, 10000000, 0);
+    printf("  idle 10 s: fixed %u polls, adaptive %u polls\n", fixed.polls, adapt.polls);
+    assert(adapt.polls * 5 < fixed.polls);
+}
+
+// 4. Touch after a long idle: the first frame waits at most one deep-tier
+//    interval, then nothing is missed and the scheduler re-locks.
+static void test_snap_back(void) {
+    run_stats_t st = run(true, 8000, 10000700, 10500700, 10600000, 1234);
+    printf("  touch after 10 s idle: first report after %.1f ms, then %u/%u frames, latency mean %.2f ms\n",
+           st.first_us / 1000.0, st.delivered, st.frames, st.latency_sum / 1000.0 / st.delivered);
+    assert(st.first_us <= (NT_SCHED_IDLE_DEEP_MS + 1) * 1000);
+    assert(st.lost == 0);
+    assert(st.latency_sum / st.delivered < 1500);
+}
+
+int main(void) {
+    test_locks_on();
+    test_fractional_period_and_wrap();
+    test_idle_backoff();
+    test_snap_back();
+    printf("All scheduler tests passed\n");
+    return 0;
+}
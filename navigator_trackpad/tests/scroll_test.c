@@ -0,0 +1,132 @@
+// Copyright 2026 ZSA Technology Labs, Inc <contact@zsa.io>
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// Standalone host test for the pure two-finger scroll engine.
+// Build & run from the module root:
+//   gcc -Wall -o /tmp/nt_scroll_test navigator_trackpad/tests/scroll_test.c
+//   /tmp/nt_scroll_test
+//
+// Feeds emit lists straight to nt_scroll_update: a two-finger stroke scrolls
+// by exactly its travel at high resolution and at notch resolution, one
+// finger and a change of pair move nothing, a fast stroke past what a report
+// carries drains after the lift without losing a count, and the direction
+// follows the natural setting.
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../navigator_trackpad_scroll.h"
+
+static const nt_scroll_cfg_t hires   = {120, 128, 127, true};
+static const nt_scroll_cfg_t notched = {1, 128, 127, true};
+
+// Two contacts (host_ids a and b) side by side, their centroid at (x, y).
+static nt_emit_list_t pair(uint8_t a, uint8_t b, uint16_t x, uint16_t y) {
+    nt_emit_list_t e = {.count = 2};
+    e.items[0]       = (nt_emit_contact_t){.host_id = a, .x = x - 150, .y = y, .tip = true, .conf = true};
+    e.items[1]       = (nt_emit_contact_t){.host_id = b, .x = x + 150, .y = y, .tip = true, .conf = true};
+    return e;
+}
+
+// Run frames until nothing is pending; returns the counts reported.
+static void drain(nt_scroll_t *s, const nt_scroll_cfg_t *cfg, long *v, long *h) {
+    nt_emit_list_t none = {0};
+    int16_t        dv, dh;
+    do {
+        assert(!nt_scroll_update(s, &none, cfg, &dv, &dh));
+        *v += dv, *h += dh;
+    } while (nt_scroll_pending(s, cfg));
+}
+
+// 1. A slow stroke down, one unit a frame, reports its whole travel: 1000
+// units at 120 counts per 128-unit notch, with no more than a count held back
+// at any time.
+static void test_slow_stroke(void) {
+    const nt_scroll_cfg_t *cfgs[] = {&hires, &notched};
+    for (int c = 0; c < 2; c++) {
+        const nt_scroll_cfg_t *cfg = cfgs[c];
+        nt_scroll_t            s   = {0};
+        long                   v = 0, h = 0;
+        int16_t                dv, dh;
+        for (int i = 0; i <= 1000; i++) {
+            nt_emit_list_t e = pair(0, 1, 1000, 500 + i);
+            assert(nt_scroll_update(&s, &e, cfg, &dv, &dh));
+            assert(dh == 0 && dv >= 0);
+            v += dv;
+            assert(labs(v * 128 - (long)i * cfg->counts_per_notch) < 128 && "nothing held back");
+        }
+        drain(&s, cfg, &v, &h);
+        printf("  1000 units down at %u counts/notch: %ld counts\n", cfg->counts_per_notch, v);
+        assert(v == 1000L * cfg->counts_per_notch / 128 && h == 0);
+    }
+}
+
+// 2. One finger never scrolls; the first frame of a pair only anchors it; a
+// pair that changes (a third finger taking one's place) re-anchors rather
+// than jumping to the new centroid.
+static void test_anchoring(void) {
+    nt_scroll_t    s = {0};
+    int16_t        v, h;
+    nt_emit_list_t one = {.count = 1};
+    one.items[0]       = (nt_emit_contact_t){.host_id = 0, .x = 900, .y = 900, .tip = true, .conf = true};
+    for (int i = 0; i < 5; i++) {
+        one.items[0].y += 50;
+        assert(!nt_scroll_update(&s, &one, &hires, &v, &h) && v == 0 && h == 0);
+    }
+    nt_emit_list_t e = pair(0, 1, 1000, 1000);
+    assert(nt_scroll_update(&s, &e, &hires, &v, &h) && v == 0 && h == 0);
+    e = pair(0, 2, 1000, 1600);  // host_id 1 replaced, centroid moved
+    assert(nt_scroll_update(&s, &e, &hires, &v, &h) && v == 0 && h == 0 && "a new pair must not jump");
+    e = pair(0, 2, 1000, 1664);
+    assert(nt_scroll_update(&s, &e, &hires, &v, &h) && v == 60 && h == 0);
+
+    // A release in the list (tip=0) does not count as down.
+    e.items[1].tip = false;
+    assert(!nt_scroll_update(&s, &e, &hires, &v, &h) && v == 0);
+}
+
+// 3. A flick far past what one 8-bit report carries: every count goes out,
+// none over the report's range, finishing after the lift.
+static void test_flick_drains(void) {
+    nt_scroll_t s = {0};
+    long        v = 0, h = 0;
+    int16_t     dv, dh;
+    for (int i = 0; i < 5; i++) {
+        nt_emit_list_t e = pair(3, 4, 1000 + i * 200, 1800 - i * 300);
+        nt_scroll_update(&s, &e, &hires, &dv, &dh);
+        assert(abs(dv) <= 127 && abs(dh) <= 127);
+        v += dv, h += dh;
+    }
+    drain(&s, &hires, &v, &h);
+    printf("  flick: %ld wheel, %ld pan counts\n", v, h);
+    assert(v == -1200L * 120 / 128 && h == -800L * 120 / 128);
+}
+
+// 4. Natural scrolling moves the content with the fingers; traditional
+// scrolling is the mirror image.
+static void test_direction(void) {
+    nt_scroll_cfg_t traditional = hires;
+    traditional.natural         = false;
+    const nt_scroll_cfg_t *cfgs[] = {&hires, &traditional};
+    for (int c = 0; c < 2; c++) {
+        nt_scroll_t    s = {0};
+        int16_t        v, h;
+        nt_emit_list_t e = pair(0, 1, 1000, 1000);
+        nt_scroll_update(&s, &e, cfgs[c], &v, &h);
+        e = pair(0, 1, 1064, 1064);  // fingers down and right
+        nt_scroll_update(&s, &e, cfgs[c], &v, &h);
+        int sign = cfgs[c]->natural ? 1 : -1;
+        assert(v == sign * 60 && h == -sign * 60);
+    }
+}
+
+int main(void) {
+    test_slow_stroke();
+    test_anchoring();
+    test_flick_drains();
+    test_direction();
+    printf("All scroll tests passed\n");
+    return 0;
+}
@@ -0,0 +1,233 @@
+// Copyright 2026 ZSA Technology Labs, Inc <contact@zsa.io>
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// End-to-end host test: the full driver (staged init + PTP task) against the
+// Cirque Gen6 simulator in tests/host/cgen6_sim.h, driven by scripted finger
+// traces.
+// Build & run from the module root:
+//   gcc -Wall -Inavigator_trackpad/tests/host -o /tmp/nt_sim_test navigator_trackpad/tests/sim_test.c -lm
+//   /tmp/nt_sim_test
+// and again with -DNAVIGATOR_TRACKPAD_LENGTH_PREFIXED_READS=TRUE.
+//
+// Verifies that init puts the simulated sensor into PTP mode with the expected
+// axis configuration, that a swipe comes out as a moving contact that is
+// released at the end, that two fingers are reported as two contacts, that the
+// driver never violates the sensor's turnaround, and that a mid-stroke bus
+// fault or an unplug/power-cycle is ridden out without stranding a contact.
+// Also compares bus bytes per second of full and length-prefixed report
+// polling, idle and under motion, with the sensor modelled both re-sending a
+// partly read report and dropping it.
+
+#include "../navigator_trackpad_common.c"
+#include "../navigator_trackpad_pipeline.c"
+#include "../navigator_trackpad_ptp.c"
+#include "host/cgen6_sim.h"
+
+#define LOOP_US 100
+
+// --- Host side ---------------------------------------------------------------
+static uint32_t ptp_sends;
+static bool     host_tip;
+static uint16_t host_x, host_first_x;
+static uint8_t  host_max_contacts;
+
+void send_digitizer_touchpad(report_digitizer_touchpad_t *report) {
+    bool tip = report->fingers[0].confidence_tip & 0x02;
+    if (tip && !host_tip) {
+        host_first_x = report->fingers[0].x;
+    }
+    host_tip = tip;
+    host_x   = report->fingers[0].x;
+    if ((report->contact_count_buttons & 0x0F) > host_max_contacts) {
+        host_max_contacts = report->contact_count_buttons & 0x0F;
+    }
+    ptp_sends++;
+}
+
+void send_digitizer_touchpad_mouse(report_digitizer_touchpad_mouse_t *report) {
+    (void)report;
+}
+
+uint8_t digitizer_touchpad_get_input_mode(void) {
+    return TRACKPAD_INPUT_MODE_PTP;
+}
+
+static void run(uint64_t us) {
+    uint64_t end = mock_clock_us + us;
+    while (mock_clock_us < end) {
+        cgen6_sim_update();
+        navigator_trackpad_ptp_task();
+        mock_clock_advance_us(LOOP_US);
+    }
+}
+
+static void boot(void) {
+    cgen6_sim_reset();
+    // Length-prefixed reads need a sensor that re-sends a partly read report.
+    cgen6_sim.resend_partial = NAVIGATOR_TRACKPAD_LENGTH_PREFIXED_READS == TRUE;
+    mock_clock_advance_ms(100);
+    navigator_trackpad_init_start();
+    run(100000);
+    assert(trackpad_init);
+    ptp_sends = 0;
+    host_tip = false;
+    host_max_contacts = 0;
+}
+
+// Left-to-right swipe over 300 ms, then lift.
+static const cgen6_sim_key_t swipe[] = {
+    {.t_ms = 0, .count = 1, .fingers = {{.id = 1, .x = 600, .y = 1100}}},
+    {.t_ms = 300, .count = 1, .fingers = {{.id = 1, .x = 1600, .y = 1100}}},
+    {.t_ms = 300, .count = 0},
+};
+
+// 1. Init configures the sensor: PTP reports, swapped/inverted raw axes.
+static void test_init_configures_sensor(void) {
+    boot();
+    printf("  init: FEED_CONFIG4 0x%02X, XY_CONFIG 0x%02X, %u reads, %u writes\n",
+           cgen6_sim_peek(CGEN6_FEED_CONFIG4), cgen6_sim_peek(CGEN6_XY_CONFIG), cgen6_sim.stats.mem_reads,
+           cgen6_sim.stats.mem_writes);
+    assert(cgen6_sim_peek(CGEN6_FEED_CONFIG4) == ((CGEN6_SIM_FEED_CONFIG4_DEFAULT & 0xF7) | 0x04));
+    assert(cgen6_sim_peek(CGEN6_XY_CONFIG) == 0x0F);
+    assert(cgen6_sim.stats.bad_writes == 0 && cgen6_sim.stats.guard_violations == 0);
+}
+
+// 2. A swipe: the host sees a contact moving the right way, then a release.
+static void test_swipe(void) {
+    boot();
+    cgen6_sim_play(swipe, 3);
+    run(400000);
+    printf("  swipe: %u frames, %u read, %u empty reads, %u reports, x %u -> %u\n", cgen6_sim.stats.frames,
+           cgen6_sim.stats.frames_read, cgen6_sim.stats.empty_reads, ptp_sends, host_first_x, host_x);
+    assert(cgen6_sim.stats.frames_read == cgen6_sim.stats.frames && cgen6_sim.stats.overruns == 0);
+    assert(host_x > host_first_x);
+    assert(!host_tip && "the contact must be released at the end of the swipe");
+    assert(host_max_contacts == 1);
+    assert(cgen6_sim.stats.guard_violations == 0);
+}
+
+// 3. Two fingers down together are reported as two contacts.
+static void test_two_fingers(void) {
+    static const cgen6_sim_key_t pinch[] = {
+        {.t_ms = 0, .count = 2, .fingers = {{.id = 1, .x = 800, .y = 800}, {.id = 2, .x = 1400, .y = 1400}}},
+        {.t_ms = 200, .count = 2, .fingers = {{.id = 1, .x = 1000, .y = 1000}, {.id = 2, .x = 1200, .y = 1200}}},
+        {.t_ms = 200, .count = 0},
+    };
+    boot();
+    cgen6_sim_play(pinch, 3);
+    run(300000);
+    assert(host_max_contacts == 2);
+    assert(!host_tip);
+}
+
+// 4. A NACK and a corrupted register read mid-stroke: the stroke continues and
+//    still ends with a release.
+static void test_fault_mid_stroke(void) {
+    boot();
+    cgen6_sim_play(swipe, 3);
+    run(100000);
+    uint32_t sends = ptp_sends;
+    mock_bus_inject_fault(I2C_STATUS_ERROR, 2);
+    cgen6_sim.fault.corrupt_cksum = 1;
+    run(300000);
+    const navigator_trackpad_error_stats_t *st = navigator_trackpad_get_error_stats();
+    printf("  fault mid-stroke: %u reports after the fault, nacks %u, cksum %u, recoveries %u\n",
+           ptp_sends - sends, st->nacks, st->cksum_failures, st->recoveries);
+    assert(trackpad_init);
+    assert(ptp_sends > sends + 10);
+    assert(!host_tip);
+}
+
+// 5. Unplug, power-cycle and replug: the driver reconfigures the sensor.
+static void test_replug_power_cycle(void) {
+    boot();
+    mock_bus_present = false;
+    run(50000);
+    cgen6_sim_power_cycle();
+    mock_bus_present = true;
+    run(NAVIGATOR_TRACKPAD_PROBE_INTERVAL_MS * 1000 + 200000);
+    assert(trackpad_init);
+    assert(cgen6_sim_peek(CGEN6_FEED_CONFIG4) & 0x04);
+    assert(cgen6_sim_peek(CGEN6_XY_CONFIG) == 0x0F);
+
+    cgen6_sim_play(swipe, 3);
+    run(400000);
+    assert(ptp_sends > 0 && !host_tip);
+}
+
+// Poll the sensor every NAVIGATOR_TRACKPAD_POLL_INTERVAL_MS for `us`, with full
+// or length-prefixed reads; returns the number of reports decoded.
+static uint32_t poll_reports(uint64_t us, bool prefixed) {
+    uint32_t reports = 0, last_poll = timer_read32();
+    uint64_t end     = mock_clock_us + us;
+    bool     queued  = false;
+    while (mock_clock_us < end) {
+        cgen6_sim_update();
+        cgen6_xfer_state_t st = cgen6_xfer_poll();
+        if (st == CGEN6_XFER_READY) {
+            cgen6_report_t r = {0};
+            if (cgen6_xfer_take_queued_header()) {
+                queued = true;
+            } else {
+                reports += cirque_gen_6_collect_report(&r);
+            }
+        } else if (st == CGEN6_XFER_IDLE && queued) {
+            queued = false;
+            cgen6_xfer_start_report(CGEN6_MAX_PACKET_SIZE);
+        } else if (st == CGEN6_XFER_IDLE && timer_elapsed32(last_poll) >= NAVIGATOR_TRACKPAD_POLL_INTERVAL_MS) {
+            last_poll = timer_read32();
+            if (prefixed) {
+                cgen6_xfer_start_report_header();
+            } else {
+                cgen6_xfer_start_report(CGEN6_MAX_PACKET_SIZE);
+            }
+        }
+        mock_clock_advance_us(LOOP_US);
+    }
+    return reports;
+}
+
+// 6. Length-prefixed reads: against a sensor that re-sends a partly read
+// report, the same reports for a fraction of the idle bus traffic; against
+// one that drops it, most reports are lost (why they are off by default).
+static void test_prefixed_bus_bytes(void) {
+    static const cgen6_sim_key_t hold[] = {
+        {.t_ms = 0, .count = 1, .fingers = {{.id = 1, .x = 600, .y = 600}}},
+        {.t_ms = 1000, .count = 1, .fingers = {{.id = 1, .x = 1600, .y = 1600}}},
+    };
+    // 0: full reads, 1: prefixed with re-send, 2: prefixed without
+    uint32_t idle_bytes[3], motion_bytes[3], motion_reports[3];
+    for (int mode = 0; mode < 3; mode++) {
+        bool prefixed = mode > 0;
+        boot();
+        cgen6_sim.resend_partial = mode == 1;
+        uint32_t bytes           = mock_bus_stats.bytes;
+        assert(poll_reports(1000000, prefixed) == 0);
+        idle_bytes[mode] = mock_bus_stats.bytes - bytes;
+
+        cgen6_sim_play(hold, 2);
+        bytes                = mock_bus_stats.bytes;
+        motion_reports[mode] = poll_reports(1000000, prefixed);
+        motion_bytes[mode]   = mock_bus_stats.bytes - bytes;
+        assert(cgen6_sim.stats.guard_violations == 0);
+    }
+    printf("  bus bytes/s: idle full %u, prefixed %u | motion full %u (%u reports), prefixed %u (%u reports)\n",
+           idle_bytes[0], idle_bytes[1], motion_bytes[0], motion_reports[0], motion_bytes[1], motion_reports[1]);
+    printf("  prefixed reads, sensor dropping partly read reports: %u of %u reports\n", motion_reports[2],
+           motion_reports[0]);
+    assert(motion_reports[1] == motion_reports[0] && "prefixed reads must not lose reports");
+    assert(idle_bytes[1] * 4 < idle_bytes[0]);
+    assert(motion_bytes[1] < motion_bytes[0]);
+    assert(motion_reports[2] * 2 < motion_reports[0] && "the drop model must show the loss");
+}
+
+int main(void) {
+    test_init_configures_sensor();
+    test_swipe();
+    test_two_fingers();
+    test_fault_mid_stroke();
+    test_replug_power_cycle();
+    test_prefixed_bus_bytes();
+    printf("All simulator tests passed\n");
+    return 0;
+}
@@ -0,0 +1,134 @@
+// Copyright 2026 ZSA Technology Labs, Inc <contact@zsa.io>
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// Host test for the fused sensor-to-logical transform.
+// Build & run from the module root:
+//   gcc -Wall -Inavigator_trackpad/tests/host -o /tmp/nt_transform_test navigator_trackpad/tests/transform_test.c -lm
+//   /tmp/nt_transform_test
+//
+// Sweeps every raw sensor coordinate (plus a margin outside the usable area)
+// at right and arbitrary angles, with and without the LUT, and compares both
+// the fused transform and the staged pipeline against an exact double
+// reference rounded once. The fused transform must land within one unit
+// everywhere and round exactly far more often than the staged pipeline. (At
+// arbitrary angles the staged pipeline is off by tens of units near the edges,
+// where it clamps the corrected point before rotating it.) Prints the cost of
+// both per point for comparison.
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../navigator_trackpad_transform.h"
+
+#define MARGIN 10
+
+// Exact: unrounded scale, bilinear field, rotation, one rounding and clamp.
+static void exact(uint16_t raw_x, uint16_t raw_y, int deg, bool lut, int32_t *ox, int32_t *oy) {
+    if (raw_x < SENSOR_X_MIN) raw_x = SENSOR_X_MIN;
+    if (raw_x > SENSOR_X_MAX) raw_x = SENSOR_X_MAX;
+    if (raw_y < SENSOR_Y_MIN) raw_y = SENSOR_Y_MIN;
+    if (raw_y > SENSOR_Y_MAX) raw_y = SENSOR_Y_MAX;
+    double x = (raw_x - SENSOR_X_MIN) * (double)SENSOR_SCALE_X_MULT / 65536.0;
+    double y = (raw_y - SENSOR_Y_MIN) * (double)SENSOR_SCALE_Y_MULT / 65536.0;
+    if (lut) {
+        double fx = x / NT_LUT_CELL_UNITS, fy = y / NT_LUT_CELL_UNITS;
+        int    ix = fx >= NT_LUT_G - 1 ? NT_LUT_G - 2 : (int)fx, iy = fy >= NT_LUT_G - 1 ? NT_LUT_G - 2 : (int)fy;
+        double tx = fx - ix, ty = fy - iy;
+#define BILINEAR(M) \
+    ((M)[ix][iy] * (1 - tx) * (1 - ty) + (M)[ix + 1][iy] * tx * (1 - ty) + (M)[ix][iy + 1] * (1 - tx) * ty + (M)[ix + 1][iy + 1] * tx * ty)
+        double ex = BILINEAR(NT_LUT_EX), ey = BILINEAR(NT_LUT_EY);
+#undef BILINEAR
+        x -= ex;
+        y -= ey;
+    }
+    double c = cos(deg * M_PI / 180.0), s = sin(deg * M_PI / 180.0);
+    double dx = x - NAVIGATOR_TRACKPAD_CENTER_X, dy = y - NAVIGATOR_TRACKPAD_CENTER_Y;
+    double rx = round(NAVIGATOR_TRACKPAD_CENTER_X + dx * c - dy * s);
+    double ry = round(NAVIGATOR_TRACKPAD_CENTER_Y + dx * s + dy * c);
+    *ox = rx < 0 ? 0 : rx > TRACKPAD_LOGICAL_MAX ? TRACKPAD_LOGICAL_MAX : (int32_t)rx;
+    *oy = ry < 0 ? 0 : ry > TRACKPAD_LOGICAL_MAX ? TRACKPAD_LOGICAL_MAX : (int32_t)ry;
+}
+
+static int max_abs(int32_t a, int32_t b) {
+    return abs(a) > abs(b) ? abs(a) : abs(b);
+}
+
+// The whole raw range (plus MARGIN) at one angle.
+static void sweep(int deg, bool lut) {
+    int32_t  cos_q14 = NT_TRANSFORM_Q14(cosf(deg * 3.14159265358979f / 180.0f));
+    int32_t  sin_q14 = NT_TRANSFORM_Q14(sinf(deg * 3.14159265358979f / 180.0f));
+    float    cos_t = cosf(deg * 3.14159265358979f / 180.0f), sin_t = sinf(deg * 3.14159265358979f / 180.0f);
+    uint32_t n = 0, fused_off = 0, staged_off = 0;
+    int      fused_worst = 0, staged_worst = 0, between = 0;
+    for (uint16_t rx = SENSOR_X_MIN - MARGIN; rx <= SENSOR_X_MAX + MARGIN; rx++) {
+        for (uint16_t ry = SENSOR_Y_MIN - MARGIN; ry <= SENSOR_Y_MAX + MARGIN; ry++) {
+            int32_t  ex, ey;
+            uint16_t fx, fy, sx, sy;
+            exact(rx, ry, deg, lut, &ex, &ey);
+            nt_transform_point(rx, ry, cos_q14, sin_q14, lut ? &NT_LUT_COMPILED : NULL, &fx, &fy);
+            nt_transform_staged(rx, ry, cos_t, sin_t, lut, &sx, &sy);
+            int f = max_abs(fx - ex, fy - ey), s = max_abs(sx - ex, sy - ey), b = max_abs(fx - sx, fy - sy);
+            fused_off += f != 0;
+            staged_off += s != 0;
+            if (f > fused_worst) fused_worst = f;
+            if (s > staged_worst) staged_worst = s;
+            if (b > between) between = b;
+            n++;
+        }
+    }
+    printf("  %3d deg, LUT %-3s: off exact by >0: fused %5.2f%% (max %d), staged %5.2f%% (max %d); fused vs staged max %d\n",
+           deg, lut ? "on" : "off", 100.0 * fused_off / n, fused_worst, 100.0 * staged_off / n, staged_worst, between);
+    fflush(stdout);
+    assert(fused_worst <= 1 && "fused transform must be within one unit of exact");
+    assert(fused_off * 10 < n && "fused transform should round exactly almost everywhere");
+    assert(fused_off < staged_off && "one rounding must beat three");
+}
+
+// 1. Right angles and arbitrary angles, LUT on and off.
+static void test_sweeps(void) {
+    static const int angles[] = {0, 90, 180, 270, 30, 315};
+    for (unsigned i = 0; i < sizeof(angles) / sizeof(angles[0]); i++) {
+        sweep(angles[i], true);
+        sweep(angles[i], false);
+    }
+}
+
+// 2. Per-point cost at an arbitrary angle, for reference (the host has an FPU).
+static double ns_per_point(bool fused, int deg) {
+    int32_t           cos_q14 = NT_TRANSFORM_Q14(cosf(deg * 3.14159265358979f / 180.0f));
+    int32_t           sin_q14 = NT_TRANSFORM_Q14(sinf(deg * 3.14159265358979f / 180.0f));
+    float             cos_t = cosf(deg * 3.14159265358979f / 180.0f), sin_t = sinf(deg * 3.14159265358979f / 180.0f);
+    volatile uint32_t sink = 0;
+    struct timespec   t0, t1;
+    uint32_t          n = 0;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (uint16_t rx = SENSOR_X_MIN; rx <= SENSOR_X_MAX; rx += 2) {
+        for (uint16_t ry = SENSOR_Y_MIN; ry <= SENSOR_Y_MAX; ry += 2) {
+            uint16_t ox, oy;
+            if (fused) {
+                nt_transform_point(rx, ry, cos_q14, sin_q14, &NT_LUT_COMPILED, &ox, &oy);
+            } else {
+                nt_transform_staged(rx, ry, cos_t, sin_t, true, &ox, &oy);
+            }
+            sink += ox + oy;
+            n++;
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    (void)sink;
+    return ((t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec)) / n;
+}
+
+static void test_cost(void) {
+    double s = ns_per_point(false, 30), f = ns_per_point(true, 30);
+    printf("  cost per point at 30 deg (host): staged %.1f ns, fused %.1f ns\n", s, f);
+}
+
+int main(void) {
+    test_sweeps();
+    test_cost();
+    printf("All transform tests passed\n");
+    return 0;
+}
@@ -0,0 +1,173 @@
+// Copyright 2026 ZSA Technology Labs, Inc <contact@zsa.io>
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// Host test for the asynchronous Cirque Gen6 transaction layer, run against
+// the mock I2C bus and fake clock in tests/host.
+// Build & run from the module root:
+//   gcc -Wall -Inavigator_trackpad/tests/host -o /tmp/nt_transport_test navigator_trackpad/tests/transport_test.c
+//   /tmp/nt_transport_test
+//
+// Verifies that issuing a transfer never busy-waits, that the sensor's
+// turnaround is still honoured before the next transfer, that results and
+// errors come back intact on collection, and compares the CPU spent spinning
+// per second of 5 ms polling against the blocking path.
+
+#include "../navigator_trackpad_common.c"
+#include "host/mock_bus.h"
+
+static const uint8_t ptp_packet[CGEN6_MAX_PACKET_SIZE] = {
+    0x11, 0x00, CGEN6_PTP_REPORT_ID,
+    0x0B, 0x34, 0x02, 0x78, 0x01,  // finger 0: id 2, tip, conf, x=0x234, y=0x178
+    0x00, 0x00, 0x00, 0x00, 0x00,  // finger 1: up
+    0x50, 0x00,                    // scan time
+    0x01, 0x00,                    // contact count, buttons
+};
+
+static void setup(void) {
+    mock_bus_reset();
+    mock_clock_advance_ms(10);
+    cgen6_xfer_flush();
+    trackpad_init = true;
+}
+
+// 1. Issuing a report read returns without spinning; the result is collected
+//    later and the next transfer waits out the turnaround.
+static void test_report_issue_does_not_spin(void) {
+    setup();
+    mock_bus_push_read(ptp_packet, sizeof ptp_packet);
+
+    assert(cgen6_xfer_poll() == CGEN6_XFER_IDLE);
+    assert(cgen6_xfer_start_report(CGEN6_MAX_PACKET_SIZE));
+    assert(mock_bus_stats.spin_us == 0 && "issuing a transfer must not busy-wait");
+    assert(mock_bus_stats.transactions == 1);
+
+    assert(cgen6_xfer_poll() == CGEN6_XFER_READY);
+    assert(!cgen6_xfer_start_report(CGEN6_MAX_PACKET_SIZE) && "one transfer in flight at a time");
+
+    cgen6_report_t r = {0};
+    assert(cirque_gen_6_collect_report(&r));
+    assert(r.fingers[0].tip && r.fingers[0].confidence && r.fingers[0].id == 2);
+    assert(r.fingers[0].x == 0x234 && r.fingers[0].y == 0x178);
+    assert(r.contact_count == 1 && r.scan_time == 0x50);
+
+    // 17 bytes * 15 us = 255 us of turnaround, still running.
+    assert(cgen6_xfer_poll() == CGEN6_XFER_SETTLING);
+    assert(!cgen6_xfer_start_report(CGEN6_MAX_PACKET_SIZE));
+    mock_clock_advance_ms(2);
+    assert(cgen6_xfer_poll() == CGEN6_XFER_IDLE);
+    assert(mock_bus_stats.spin_us == 0);
+}
+
+// 2. Memory reads are checked on collection: good checksum passes, a corrupted
+//    one is reported.
+static void test_memory_read_checks(void) {
+    setup();
+    uint8_t reg[2] = {0x5A, 0xA5};
+    mock_bus_push_memory(reg, 2);
+    assert(cgen6_xfer_start_read(CGEN6_XY_CONFIG, 2, false));
+    assert(mock_last_write_len == 8 && mock_last_write[0] == 0x01 && mock_last_write[1] == 0x09);
+    uint8_t out[2] = {0};
+    assert(cgen6_xfer_collect(out, 2) == CGEN6_SUCCESS);
+    assert(out[0] == 0x5A && out[1] == 0xA5);
+
+    mock_clock_advance_ms(3);
+    uint8_t bad[5] = {0x05, 0x00, 0x5A, 0xA5, 0x00};  // wrong checksum
+    mock_bus_push_read(bad, sizeof bad);
+    assert(cgen6_xfer_start_read(CGEN6_XY_CONFIG, 2, false));
+    assert(cgen6_xfer_collect(out, 2) == CGEN6_CKSUM_FAILED);
+
+    // Fast reads skip the checks (and use the shorter turnaround).
+    mock_clock_advance_ms(3);
+    mock_bus_push_read(bad, sizeof bad);
+    assert(cgen6_xfer_start_read(CGEN6_I2C_DR, 2, true));
+    assert(cgen6_xfer_collect(out, 2) == CGEN6_SUCCESS);
+    assert(mock_bus_stats.spin_us == 0);
+}
+
+// 3. Writes carry the preamble and checksum.
+static void test_write_framing(void) {
+    setup();
+    uint8_t v = 0x07;
+    assert(cgen6_xfer_start_write(CGEN6_XY_CONFIG, &v, 1));
+    assert(mock_last_write_len == 10);
+    assert(mock_last_write[0] == 0x00 && mock_last_write[1] == 0x09 && mock_last_write[8] == 0x07);
+    uint8_t cksum = 0;
+    for (int i = 0; i < 9; i++) cksum += mock_last_write[i];
+    assert(mock_last_write[9] == cksum);
+    assert(cgen6_xfer_collect(NULL, 0) == CGEN6_SUCCESS);
+}
+
+// 4. A bus failure surfaces on collection and drops trackpad_init so the task
+//    falls back to the probe path.
+static void test_bus_failure(void) {
+    setup();
+    mock_bus_inject_fault(I2C_STATUS_TIMEOUT, 1);
+    assert(cgen6_xfer_start_report(CGEN6_MAX_PACKET_SIZE));
+    assert(!trackpad_init);
+    cgen6_report_t r = {0};
+    assert(!cirque_gen_6_collect_report(&r));
+    // No turnaround after a failed read: the bus is free again immediately.
+    assert(cgen6_xfer_poll() == CGEN6_XFER_IDLE);
+}
+
+// 5. The blocking wrappers keep the original timing for the init path.
+static void test_blocking_wrappers(void) {
+    setup();
+    uint8_t reg = 0x42;
+    mock_bus_push_memory(&reg, 1);
+    assert(cirque_gen6_read_reg(CGEN6_XY_CONFIG, false) == 0x42);
+    assert(mock_bus_stats.spin_us == CGEN6_MEMORY_GUARD_US);
+    assert(cgen6_xfer_poll() == CGEN6_XFER_IDLE);
+}
+
+// 6. One second of 5 ms polling, called from a 10 kHz main loop: the async
+//    path never spins; the blocking path spins 255 us per poll.
+static void test_poll_cpu_budget(void) {
+    setup();
+    uint32_t last_poll = timer_read32();
+    uint32_t reports   = 0;
+    uint64_t end       = mock_clock_us + 1000000;
+    while (mock_clock_us < end) {
+        cgen6_xfer_state_t st = cgen6_xfer_poll();
+        if (st == CGEN6_XFER_READY) {
+            cgen6_report_t r = {0};
+            cirque_gen_6_collect_report(&r);
+            reports++;
+        } else if (st == CGEN6_XFER_IDLE && timer_elapsed32(last_poll) >= NAVIGATOR_TRACKPAD_POLL_INTERVAL_MS) {
+            last_poll = timer_read32();
+            cgen6_xfer_start_report(CGEN6_MAX_PACKET_SIZE);
+        }
+        mock_clock_advance_us(100);
+    }
+    uint64_t async_spin = mock_bus_stats.spin_us;
+    uint64_t async_bus  = mock_bus_stats.bus_us;
+
+    setup();
+    end = mock_clock_us + 1000000;
+    uint32_t blocking_reports = 0;
+    while (mock_clock_us < end) {
+        cgen6_report_t r = {0};
+        cirque_gen_6_read_report(&r);
+        blocking_reports++;
+        mock_clock_advance_ms(NAVIGATOR_TRACKPAD_POLL_INTERVAL_MS);
+    }
+    uint64_t blocking_spin = mock_bus_stats.spin_us;
+
+    printf("  1 s @ %d ms poll: async %u reads, spin %llu us, bus %llu us | blocking %u reads, spin %llu us (%.1f%% CPU)\n",
+           NAVIGATOR_TRACKPAD_POLL_INTERVAL_MS, reports, (unsigned long long)async_spin, (unsigned long long)async_bus,
+           blocking_reports, (unsigned long long)blocking_spin, blocking_spin / 10000.0);
+    assert(reports >= 190 && "async path must keep up with the poll rate");
+    assert(async_spin == 0 && "async path must never busy-wait");
+    assert(blocking_spin > 0);
+}
+
+int main(void) {
+    test_report_issue_does_not_spin();
+    test_memory_read_checks();
+    test_write_framing();
+    test_bus_failure();
+    test_blocking_wrappers();
+    test_poll_cpu_budget();
+    printf("All transport tests passed\n");
+    return 0;
+}
@@ -0,0 +1,358 @@
+// Copyright 2026 ZSA Technology Labs, Inc <contact@zsa.io>
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// nt_bench: host microbenchmark of the trackpad's per-frame kernels, with the
+// results as JSON so runs before and after a change can be diffed.
+// Build from the module root, with the same -D options as the firmware:
+//   gcc -O2 -Wall -Inavigator_trackpad/tests/host -o nt_bench navigator_trackpad/tools/nt_bench.c -lm
+//
+// Usage: nt_bench [-r passes] [-k kernel]
+//
+// Every kernel runs over the same synthetic trace: rests with +/-8 units of
+// jitter, straight strokes and circles, with a second finger, lifts and id
+// changes for the reconciler. Each figure is the best of several timed runs,
+// per call: one point for the geometry and filter kernels, one frame for
+// reconcile and the full pipeline.
+//
+// Instruction counts come from the Linux perf counters when the kernel allows
+// it (perf_event_paranoid <= 2), else they are null. For a target-like count
+// of a build without an FPU, cross-compile with soft float and run one kernel
+// at a time under an instruction counter, e.g.
+//   arm-linux-gnueabi-gcc -O2 -mfloat-abi=soft -static ... -o nt_bench_arm
+//   valgrind --tool=callgrind ./nt_bench_arm -k euro_float   (or qemu-arm -plugin libinsn.so)
+// and subtract the count for -k none, which builds the trace and stops.
+//
+//   -r  passes over the trace per timed run (default 64)
+//   -k  run only this kernel, once, with no timing or output
+
+#include <linux/perf_event.h>
+#include <stdlib.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#include "../navigator_trackpad_pipeline.c"
+
+#define TRACE_LEN 4096
+#define TRIALS 7
+
+// --- Trace -----------------------------------------------------------------------
+typedef struct {
+    uint16_t            lx[2], ly[2];  // logical position of each finger
+    uint16_t            rx[2], ry[2];  // the same, in sensor units
+    uint8_t             id[2];
+    uint8_t             n;             // fingers down
+    uint16_t            scan_time;
+    nt_sensor_contact_t cur[2];
+    cgen6_report_t      frame;
+} bench_frame_t;
+
+static bench_frame_t trace[TRACE_LEN];
+
+static uint32_t rng = 1;
+static int32_t  jitter(int32_t amp) {  // uniform [-amp, amp]
+    rng = rng * 1664525u + 1013904223u;
+    return (int32_t)((rng >> 16) % (2 * amp + 1)) - amp;
+}
+
+static uint16_t clamp_logical(int32_t v) {
+    return v < 0 ? 0 : v > TRACKPAD_LOGICAL_MAX ? TRACKPAD_LOGICAL_MAX : (uint16_t)v;
+}
+
+// Segments of 256 frames, cycling rest / stroke / circle / two-finger stroke /
+// lift, with ids changing on every new touch as the sensor does.
+static void make_trace(void) {
+    uint8_t next_id = 0;
+    for (int i = 0; i < TRACE_LEN; i++) {
+        bench_frame_t *f   = &trace[i];
+        int            seg = i / 256 % 5, k = i % 256;
+        if (k == 0) next_id = (next_id + 2) & 0x3F;
+        double x = 1024, y = 1024, x2 = 0, y2 = 0;
+        switch (seg) {
+            case 0: x = 700, y = 900; break;
+            case 1: x = 200 + k * 6.5, y = 400 + k * 4.0; break;
+            case 2: x = 1024 + 600 * cos(k * 0.05), y = 1024 + 600 * sin(k * 0.05); break;
+            case 3: x = 300 + k * 5.0, y = 700, x2 = 300 + k * 5.0, y2 = 1100; break;
+        }
+        f->n = seg == 4 || (k > 240 && seg != 0) ? 0 : seg == 3 ? 2 : 1;
+        for (int c = 0; c < f->n; c++) {
+            f->lx[c] = clamp_logical((int32_t)(c ? x2 : x) + jitter(8));
+            f->ly[c] = clamp_logical((int32_t)(c ? y2 : y) + jitter(8));
+            f->rx[c] = SENSOR_X_MIN + (uint32_t)f->lx[c] * (SENSOR_X_MAX - SENSOR_X_MIN) / TRACKPAD_LOGICAL_MAX;
+            f->ry[c] = SENSOR_Y_MIN + (uint32_t)f->ly[c] * (SENSOR_Y_MAX - SENSOR_Y_MIN) / TRACKPAD_LOGICAL_MAX;
+            f->id[c] = (next_id + c) & 0x3F;
+            f->cur[c] = (nt_sensor_contact_t){f->id[c], f->lx[c], f->ly[c], true};
+            f->frame.fingers[c] =
+                (cgen6_finger_t){.tip = 1, .confidence = 1, .id = f->id[c], .x = f->rx[c], .y = f->ry[c]};
+        }
+        f->scan_time           = (uint16_t)(i * 80);
+        f->frame.scan_time     = f->scan_time;
+        f->frame.contact_count = f->n;
+    }
+}
+
+// --- Kernels ---------------------------------------------------------------------
+// Each runs one pass over the trace and returns a checksum, so nothing is
+// optimised away, and counts its calls in *ops.
+
+#define NT_BENCH_COS30 0.8660254f
+#define NT_BENCH_SIN30 0.5f
+
+static uint32_t k_none(uint32_t *ops) {
+    *ops += 0;
+    return 0;
+}
+
+static uint32_t k_rotate_float(uint32_t *ops) {
+    uint32_t sum = 0;
+    for (int i = 0; i < TRACE_LEN; i++) {
+        uint16_t x, y;
+        nt_rotate_point(trace[i].lx[0], trace[i].ly[0], 1024, 1024, NT_BENCH_COS30, NT_BENCH_SIN30,
+                        TRACKPAD_LOGICAL_MAX, &x, &y);
+        sum += x ^ y;
+    }
+    *ops += TRACE_LEN;
+    return sum;
+}
+
+static uint32_t k_rotate_ortho(uint32_t *ops) {
+    uint32_t sum = 0;
+    for (int i = 0; i < TRACE_LEN; i++) {
+        uint16_t x, y;
+        nt_rotate_point_ortho(trace[i].lx[0], trace[i].ly[0], 1024, 1024, 1, TRACKPAD_LOGICAL_MAX, &x, &y);
+        sum += x ^ y;
+    }
+    *ops += TRACE_LEN;
+    return sum;
+}
+
+static uint32_t k_lut_correct(uint32_t *ops) {
+    uint32_t sum = 0;
+    for (int i = 0; i < TRACE_LEN; i++) {
+        uint16_t x = trace[i].lx[0], y = trace[i].ly[0];
+        nt_lut_correct(&x, &y);
+        sum += x ^ y;
+    }
+    *ops += TRACE_LEN;
+    return sum;
+}
+
+static uint32_t k_lut_correct_float(uint32_t *ops) {
+    uint32_t sum = 0;
+    for (int i = 0; i < TRACE_LEN; i++) {
+        uint16_t x = trace[i].lx[0], y = trace[i].ly[0];
+        nt_lut_correct_float(&x, &y);
+        sum += x ^ y;
+    }
+    *ops += TRACE_LEN;
+    return sum;
+}
+
+// Scale, LUT and a 30 degree rotation fused, as the pipeline runs them.
+static uint32_t k_transform(uint32_t *ops) {
+    uint32_t sum = 0;
+    for (int i = 0; i < TRACE_LEN; i++) {
+        uint16_t x, y;
+        nt_transform_point(trace[i].rx[0], trace[i].ry[0], NT_TRANSFORM_COS_Q14(30), NT_TRANSFORM_SIN_Q14(30),
+                           &NT_LUT_COMPILED, &x, &y);
+        sum += x ^ y;
+    }
+    *ops += TRACE_LEN;
+    return sum;
+}
+
+static uint32_t k_euro_float(uint32_t *ops) {
+    nt_euro_point_t  p   = {0};
+    nt_frame_clock_t clk = {0};
+    uint32_t         sum = 0;
+    for (int i = 0; i < TRACE_LEN; i++) {
+        float dt = nt_frame_dt(&clk, trace[i].scan_time, i * 8);
+        float x = trace[i].lx[0], y = trace[i].ly[0];
+        nt_euro_point_filter(&p, &x, &y, dt, NAVIGATOR_TRACKPAD_SMOOTHING_MINCUTOFF, NAVIGATOR_TRACKPAD_SMOOTHING_BETA,
+                             NAVIGATOR_TRACKPAD_SMOOTHING_DCUTOFF);
+        sum += (uint32_t)lroundf(x) ^ (uint32_t)lroundf(y);
+    }
+    *ops += TRACE_LEN;
+    return sum;
+}
+
+static uint32_t k_euro_fixed(uint32_t *ops) {
+    nt_euro_point_fixed_t p   = {0};
+    nt_frame_clock_t      clk = {0};
+    uint32_t              sum = 0;
+    for (int i = 0; i < TRACE_LEN; i++) {
+        nt_euro_fixed_dt_t dt;
+        nt_euro_fixed_dt(&dt, nt_frame_ticks(&clk, trace[i].scan_time, i * 8),
+                         NT_EURO_HZ_Q8(NAVIGATOR_TRACKPAD_SMOOTHING_DCUTOFF));
+        int32_t x = trace[i].lx[0], y = trace[i].ly[0];
+        nt_euro_point_filter_fixed(&p, &x, &y, &dt, NT_EURO_HZ_Q8(NAVIGATOR_TRACKPAD_SMOOTHING_MINCUTOFF),
+                                   NT_EURO_BETA_Q20(NAVIGATOR_TRACKPAD_SMOOTHING_BETA));
+        sum += (uint32_t)(x ^ y);
+    }
+    *ops += TRACE_LEN;
+    return sum;
+}
+
+static uint32_t k_noise_update(uint32_t *ops) {
+    static const nt_noise_cfg_t cfg = {
+        NT_EURO_HZ_Q8(NAVIGATOR_TRACKPAD_SMOOTHING_MINCUTOFF),
+        NT_NOISE_VAR_Q4(NAVIGATOR_TRACKPAD_SMOOTHING_NOISE_REF),
+        NT_EURO_HZ_Q8(NAVIGATOR_TRACKPAD_SMOOTHING_MINCUTOFF_MIN),
+        NT_EURO_HZ_Q8(NAVIGATOR_TRACKPAD_SMOOTHING_MINCUTOFF_MAX),
+    };
+    nt_noise_t         n = NT_NOISE_INIT(cfg.nominal_q8, cfg.ref_var_q4);
+    nt_noise_contact_t c = {0};
+    for (int i = 0; i < TRACE_LEN; i++) {
+        nt_noise_update(&n, &c, trace[i].lx[0], trace[i].ly[0], &cfg);
+    }
+    *ops += TRACE_LEN;
+    return n.mincutoff_q8[0] ^ n.mincutoff_q8[1];
+}
+
+static uint32_t k_predict(uint32_t *ops) {
+    static const nt_predict_cfg_t cfg = {NT_PREDICT_Q8(NAVIGATOR_TRACKPAD_PREDICTION_ALPHA),
+                                         NT_PREDICT_Q8(NAVIGATOR_TRACKPAD_PREDICTION_BETA),
+                                         NAVIGATOR_TRACKPAD_PREDICTION_MS * 10, NAVIGATOR_TRACKPAD_PREDICTION_VMIN * 16,
+                                         NAVIGATOR_TRACKPAD_PREDICTION_MAX_LEAD};
+    nt_predict_point_t p   = {0};
+    uint32_t           sum = 0;
+    for (int i = 0; i < TRACE_LEN; i++) {
+        int32_t x = trace[i].lx[0], y = trace[i].ly[0];
+        nt_predict_point(&p, &x, &y, 80, &cfg);
+        sum += (uint32_t)(x ^ y);
+    }
+    *ops += TRACE_LEN;
+    return sum;
+}
+
+static uint32_t k_reconcile(uint32_t *ops) {
+    nt_contact_state_t st  = {0};
+    uint32_t           sum = 0;
+    for (int i = 0; i < TRACE_LEN; i++) {
+        nt_emit_list_t out;
+        nt_reconcile_contacts(&st, trace[i].cur, trace[i].n, &out);
+        sum += out.count + (out.count ? out.items[0].x : 0);
+    }
+    *ops += TRACE_LEN;
+    return sum;
+}
+
+static uint32_t k_pipeline(uint32_t *ops) {
+    static nt_pipeline_t st;
+    nt_pipeline_out_t    out;
+    uint32_t             sum = 0;
+    nt_pipeline_init(&st, NAVIGATOR_TRACKPAD_LUT_CORRECTION == TRUE ? &NT_LUT_COMPILED : NULL);
+    for (int i = 0; i < TRACE_LEN; i++) {
+        nt_pipeline_process(&st, &trace[i].frame, TRACKPAD_INPUT_MODE_PTP, i * 8, &out);
+        sum += out.ptp_send + out.ptp[3];
+    }
+    *ops += TRACE_LEN;
+    return sum;
+}
+
+typedef struct {
+    const char *name;
+    const char *unit;
+    uint32_t (*run)(uint32_t *ops);
+} kernel_t;
+
+static const kernel_t kernels[] = {
+    {"none", "pass", k_none},
+    {"rotate_point_float", "point", k_rotate_float},
+    {"rotate_point_ortho", "point", k_rotate_ortho},
+    {"lut_correct", "point", k_lut_correct},
+    {"lut_correct_float", "point", k_lut_correct_float},
+    {"transform_point", "point", k_transform},
+    {"euro_float", "point", k_euro_float},
+    {"euro_fixed", "point", k_euro_fixed},
+    {"noise_update", "point", k_noise_update},
+    {"predict_point", "point", k_predict},
+    {"reconcile_contacts", "frame", k_reconcile},
+    {"pipeline_process", "frame", k_pipeline},
+};
+#define KERNEL_COUNT (sizeof(kernels) / sizeof(kernels[0]))
+
+// --- Measurement -----------------------------------------------------------------
+static volatile uint32_t sink;
+
+static int perf_open(void) {
+    struct perf_event_attr attr = {0};
+    attr.type                   = PERF_TYPE_HARDWARE;
+    attr.size                   = sizeof(attr);
+    attr.config                 = PERF_COUNT_HW_INSTRUCTIONS;
+    attr.disabled               = 1;
+    attr.exclude_kernel         = 1;
+    attr.exclude_hv             = 1;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+int main(int argc, char **argv) {
+    int         passes = 64, c;
+    const char *only   = NULL;
+    while ((c = getopt(argc, argv, "r:k:")) != -1) {
+        switch (c) {
+            case 'r': passes = atoi(optarg); break;
+            case 'k': only = optarg; break;
+            default: fprintf(stderr, "usage: %s [-r passes] [-k kernel]\n", argv[0]); return 2;
+        }
+    }
+    if (passes < 1) passes = 1;
+    make_trace();
+
+    if (only) {
+        for (size_t k = 0; k < KERNEL_COUNT; k++) {
+            if (strcmp(only, kernels[k].name) == 0) {
+                uint32_t ops = 0;
+                sink         = kernels[k].run(&ops);
+                return 0;
+            }
+        }
+        fprintf(stderr, "unknown kernel %s\n", only);
+        return 2;
+    }
+
+    int perf = perf_open();
+    printf("{\n  \"trace_len\": %d,\n  \"passes\": %d,\n", TRACE_LEN, passes);
+    printf("  \"config\": {\"fixed_point\": %s, \"adaptive\": %s, \"prediction\": %s, \"rotation\": %d},\n",
+           NAVIGATOR_TRACKPAD_SMOOTHING_FIXED_POINT == TRUE ? "true" : "false",
+           NAVIGATOR_TRACKPAD_SMOOTHING_ADAPTIVE == TRUE ? "true" : "false",
+           NAVIGATOR_TRACKPAD_PTP_PREDICTION == TRUE ? "true" : "false", NAVIGATOR_TRACKPAD_ROTATION);
+    printf("  \"kernels\": [\n");
+    for (size_t k = 1; k < KERNEL_COUNT; k++) {
+        double   best = 1e300;
+        uint32_t ops  = 0;
+        for (int t = 0; t < TRIALS; t++) {
+            ops       = 0;
+            double t0 = now_ns();
+            for (int p = 0; p < passes; p++) sink += kernels[k].run(&ops);
+            double ns = (now_ns() - t0) / ops;
+            if (ns < best) best = ns;
+        }
+
+        long long insns = -1;
+        if (perf >= 0) {
+            ops = 0;
+            ioctl(perf, PERF_EVENT_IOC_RESET, 0);
+            ioctl(perf, PERF_EVENT_IOC_ENABLE, 0);
+            for (int p = 0; p < passes; p++) sink += kernels[k].run(&ops);
+            ioctl(perf, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(perf, &insns, sizeof(insns)) != sizeof(insns)) insns = -1;
+        }
+        printf("    {\"name\": \"%s\", \"unit\": \"%s\", \"ns_per_op\": %.2f, \"instructions_per_op\": ",
+               kernels[k].name, kernels[k].unit, best);
+        if (insns >= 0) {
+            printf("%.1f}", (double)insns / ops);
+        } else {
+            printf("null}");
+        }
+        printf("%s\n", k + 1 < KERNEL_COUNT ? "," : "");
+    }
+    printf("  ]\n}\n");
+    return 0;
+}
@@ -0,0 +1,160 @@
+// Copyright 2026 ZSA Technology Labs, Inc <contact@zsa.io>
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// nt_lut_fit: fit a per-unit distortion grid from straightedge strokes.
+// Build from the module root:
+//   gcc -O2 -Wall -o nt_lut_fit navigator_trackpad/tools/nt_lut_fit.c -lm
+//
+// Usage: nt_lut_fit [-g grid] [-s smooth] [-r ridge] [-o table.bin] [-c] strokes.txt
+//
+// strokes.txt holds one "x y" point per line, in logical units, with a blank
+// line between strokes; '#' starts a comment. Record it from the host (e.g.
+// the ABS_MT_POSITION_X/Y events of `libinput record`) while dragging a finger
+// along a straightedge in many directions, with the firmware built with
+// NAVIGATOR_TRACKPAD_LUT_CORRECTION, NAVIGATOR_TRACKPAD_PTP_SMOOTHING = FALSE and
+// no rotation.
+//
+//   -g  nodes per axis: 9 (default, same as the compiled table) or 17, 33
+//   -s  smoothness weight (default 0.005); raise it if the fit is noisy
+//   -r  ridge weight (default 0.001)
+//   -o  write the table as an EEPROM blob (see navigator_trackpad_lut_blob.h),
+//       to be stored with navigator_trackpad_lut_save()
+//   -c  print the grid as NT_LUT_EX_n / NT_LUT_EY_n rows for
+//       navigator_trackpad_lut.h (9x9 only)
+//
+// Prints the RMS distance of the strokes from straight lines before and after
+// the correction.
+
+#include <stdio.h>
+#include <unistd.h>
+#include "nt_lut_fit.h"
+
+typedef struct {
+    nt_fit_pt_t     *pts;
+    nt_fit_stroke_t *strokes;
+    int              npts, nstrokes, cap_pts, cap_strokes;
+} input_t;
+
+static int add_point(input_t *in, double x, double y, int *start) {
+    if (in->npts == in->cap_pts) {
+        in->cap_pts = in->cap_pts ? in->cap_pts * 2 : 4096;
+        in->pts     = realloc(in->pts, sizeof(nt_fit_pt_t) * in->cap_pts);
+        if (!in->pts) return -1;
+    }
+    if (*start < 0) *start = in->npts;
+    in->pts[in->npts++] = (nt_fit_pt_t){x, y};
+    return 0;
+}
+
+static int end_stroke(input_t *in, int *start) {
+    if (*start < 0) return 0;
+    if (in->nstrokes == in->cap_strokes) {
+        in->cap_strokes = in->cap_strokes ? in->cap_strokes * 2 : 256;
+        in->strokes     = realloc(in->strokes, sizeof(nt_fit_stroke_t) * in->cap_strokes);
+        if (!in->strokes) return -1;
+    }
+    // Points are linked up once reading is done (pts may still move).
+    in->strokes[in->nstrokes++] = (nt_fit_stroke_t){(const nt_fit_pt_t *)(intptr_t)*start, in->npts - *start};
+    *start                      = -1;
+    return 0;
+}
+
+static int read_strokes(FILE *f, input_t *in) {
+    char line[256];
+    int  start = -1;
+    while (fgets(line, sizeof line, f)) {
+        char *hash = strchr(line, '#');
+        if (hash) *hash = '\0';
+        double x, y;
+        if (sscanf(line, "%lf %lf", &x, &y) == 2) {
+            if (add_point(in, x, y, &start)) return -1;
+        } else if (strspn(line, " \t\r\n") == strlen(line) && !hash) {
+            if (end_stroke(in, &start)) return -1;
+        }
+    }
+    if (end_stroke(in, &start)) return -1;
+    for (int i = 0; i < in->nstrokes; i++) {
+        in->strokes[i].pts = in->pts + (intptr_t)in->strokes[i].pts;
+    }
+    return 0;
+}
+
+static void print_rows(const char *name, int g, const int8_t *v) {
+    for (int i = 0; i < g; i++) {
+        printf("#define %s_%d ", name, i);
+        for (int j = 0; j < g; j++) printf("%4d%s", v[i * g + j], j + 1 < g ? ", " : "\n");
+    }
+}
+
+int main(int argc, char **argv) {
+    nt_fit_opts_t opt  = NT_FIT_DEFAULTS;
+    const char   *out  = NULL;
+    int           rows = 0, c;
+    while ((c = getopt(argc, argv, "g:s:r:o:c")) != -1) {
+        switch (c) {
+            case 'g': opt.grid = atoi(optarg); break;
+            case 's': opt.smooth = atof(optarg); break;
+            case 'r': opt.ridge = atof(optarg); break;
+            case 'o': out = optarg; break;
+            case 'c': rows = 1; break;
+            default: fprintf(stderr, "usage: %s [-g grid] [-s smooth] [-r ridge] [-o table.bin] [-c] strokes.txt\n", argv[0]); return 2;
+        }
+    }
+    if (optind != argc - 1) {
+        fprintf(stderr, "usage: %s [-g grid] [-s smooth] [-r ridge] [-o table.bin] [-c] strokes.txt\n", argv[0]);
+        return 2;
+    }
+    if (!nt_lut_blob_grid_ok((uint8_t)opt.grid)) {
+        fprintf(stderr, "grid must be 2^k + 1 nodes per axis (9, 17, 33)\n");
+        return 2;
+    }
+    if (rows && opt.grid != 9) {
+        fprintf(stderr, "-c needs -g 9: the compiled table is 9x9\n");
+        return 2;
+    }
+
+    FILE *f = fopen(argv[optind], "r");
+    if (!f) {
+        perror(argv[optind]);
+        return 1;
+    }
+    input_t in = {0};
+    int     rc = read_strokes(f, &in);
+    fclose(f);
+    if (rc || in.nstrokes == 0) {
+        fprintf(stderr, "%s: no strokes read\n", argv[optind]);
+        return 1;
+    }
+
+    int     g  = opt.grid;
+    int8_t *ex = malloc((size_t)g * g), *ey = malloc((size_t)g * g);
+    if (!ex || !ey || nt_fit_lut(in.strokes, in.nstrokes, &opt, ex, ey)) {
+        fprintf(stderr, "fit failed\n");
+        return 1;
+    }
+    fprintf(stderr, "%d strokes, %d points: RMS distance from line %.2f -> %.2f units (%dx%d grid)\n", in.nstrokes,
+            in.npts, nt_fit_straightness(in.strokes, in.nstrokes, g, NULL, NULL),
+            nt_fit_straightness(in.strokes, in.nstrokes, g, ex, ey), g, g);
+
+    if (rows) {
+        print_rows("NT_LUT_EX", g, ex);
+        printf("\n");
+        print_rows("NT_LUT_EY", g, ey);
+    }
+    if (out) {
+        size_t   len  = NT_LUT_BLOB_SIZE((size_t)g);
+        uint8_t *blob = malloc(len);
+        FILE    *o    = fopen(out, "wb");
+        if (!blob || !o) {
+            perror(out);
+            return 1;
+        }
+        nt_fit_to_blob(g, ex, ey, blob);
+        if (fwrite(blob, 1, len, o) != len || fclose(o)) {
+            perror(out);
+            return 1;
+        }
+        fprintf(stderr, "wrote %zu-byte table to %s\n", len, out);
+    }
+    return 0;
+}
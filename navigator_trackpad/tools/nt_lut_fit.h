@@ -0,0 +1,297 @@
+// Copyright 2026 ZSA Technology Labs, Inc <contact@zsa.io>
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// Distortion-grid fitter for the Navigator trackpad (host only).
+//
+// Input is a set of strokes recorded along a straightedge, in logical units as
+// the firmware reports them with the LUT, rotation and smoothing disabled. The
+// fitter finds the node grid E (EX/EY, g x g, [x_node][y_node]) such that the
+// corrected points p - E(p), with E bilinear between nodes as in the
+// firmware, lie on straight lines.
+//
+// For each stroke with line normal n, n . (p - E(p)) should be constant along
+// the stroke. With n fixed that is linear in the nodes, so each pass is a
+// regularized linear least-squares solve (the per-stroke constant is removed
+// by centering each stroke's equations); n is then re-estimated from the
+// corrected points and the solve repeated. A straightedge cannot see an affine
+// warp, so the regularization (a smoothness term between neighbouring nodes
+// plus a small ridge) picks the smallest smooth field that straightens the
+// strokes. Nodes are bounded to +/-NT_LUT_BLOB_BOUND, as in the shipped table.
+//
+// Used by tools/nt_lut_fit.c and tests/lut_fit_test.c.
+
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../navigator_trackpad_lut_blob.h"
+
+#define NT_FIT_LOGICAL_MAX 2048.0
+
+typedef struct {
+    double x, y;
+} nt_fit_pt_t;
+
+typedef struct {
+    const nt_fit_pt_t *pts;
+    int                n;
+} nt_fit_stroke_t;
+
+typedef struct {
+    int    grid;        // nodes per axis: 9, 17, ...
+    int    iterations;  // line re-estimation passes
+    double smooth;      // neighbour-difference weight, per point per node
+    double ridge;       // node magnitude weight, per point per node
+} nt_fit_opts_t;
+
+static const nt_fit_opts_t NT_FIT_DEFAULTS = {.grid = 9, .iterations = 4, .smooth = 0.005, .ridge = 0.001};
+
+// Bilinear weights of point (x, y) on a g-node grid: four node indices
+// ([x_node * g + y_node]) and their weights.
+static inline void nt_fit_weights(int g, double x, double y, int idx[4], double w[4]) {
+    double cell = NT_FIT_LOGICAL_MAX / (g - 1);
+    double fx = x / cell, fy = y / cell;
+    if (fx < 0) fx = 0;
+    if (fy < 0) fy = 0;
+    int ix = fx >= g - 1 ? g - 2 : (int)fx;
+    int iy = fy >= g - 1 ? g - 2 : (int)fy;
+    double tx = fx - ix, ty = fy - iy;
+    if (tx > 1) tx = 1;
+    if (ty > 1) ty = 1;
+    idx[0] = ix * g + iy;
+    idx[1] = (ix + 1) * g + iy;
+    idx[2] = ix * g + iy + 1;
+    idx[3] = (ix + 1) * g + iy + 1;
+    w[0]   = (1 - tx) * (1 - ty);
+    w[1]   = tx * (1 - ty);
+    w[2]   = (1 - tx) * ty;
+    w[3]   = tx * ty;
+}
+
+// Corrected point p - E(p) for a field of double nodes (NULL: uncorrected).
+static inline nt_fit_pt_t nt_fit_correct(int g, const double *ex, const double *ey, nt_fit_pt_t p) {
+    if (!ex) return p;
+    int    idx[4];
+    double w[4];
+    nt_fit_weights(g, p.x, p.y, idx, w);
+    for (int k = 0; k < 4; k++) {
+        p.x -= w[k] * ex[idx[k]];
+        p.y -= w[k] * ey[idx[k]];
+    }
+    return p;
+}
+
+// Best-fit line of a stroke after correction: unit normal and sum of squared
+// perpendicular distances.
+static inline double nt_fit_line(const nt_fit_stroke_t *s, int g, const double *ex, const double *ey, double *nx,
+                                 double *ny) {
+    double mx = 0, my = 0, sxx = 0, syy = 0, sxy = 0;
+    for (int i = 0; i < s->n; i++) {
+        nt_fit_pt_t c = nt_fit_correct(g, ex, ey, s->pts[i]);
+        mx += c.x;
+        my += c.y;
+    }
+    mx /= s->n;
+    my /= s->n;
+    for (int i = 0; i < s->n; i++) {
+        nt_fit_pt_t c = nt_fit_correct(g, ex, ey, s->pts[i]);
+        sxx += (c.x - mx) * (c.x - mx);
+        syy += (c.y - my) * (c.y - my);
+        sxy += (c.x - mx) * (c.y - my);
+    }
+    // Direction of the major axis; the normal is perpendicular to it.
+    double th = 0.5 * atan2(2 * sxy, sxx - syy);
+    *nx       = -sin(th);
+    *ny       = cos(th);
+    // Minor eigenvalue: the residual sum of squares about the line.
+    double tr = sxx + syy, det = sxx * syy - sxy * sxy;
+    double l  = tr / 2 - sqrt(tr * tr / 4 - det > 0 ? tr * tr / 4 - det : 0);
+    return l > 0 ? l : 0;
+}
+
+// RMS distance of corrected stroke points from their best-fit lines. `ex`/`ey`
+// are int8 nodes as stored (NULL: uncorrected).
+static inline double nt_fit_straightness(const nt_fit_stroke_t *s, int ns, int g, const int8_t *ex, const int8_t *ey) {
+    double *dx = NULL, *dy = NULL;
+    if (ex) {
+        dx = malloc(sizeof(double) * g * g);
+        dy = malloc(sizeof(double) * g * g);
+        for (int k = 0; k < g * g; k++) {
+            dx[k] = ex[k];
+            dy[k] = ey[k];
+        }
+    }
+    double ss = 0, nx, ny;
+    long   n  = 0;
+    for (int i = 0; i < ns; i++) {
+        ss += nt_fit_line(&s[i], g, dx, dy, &nx, &ny);
+        n += s[i].n;
+    }
+    free(dx);
+    free(dy);
+    return n ? sqrt(ss / n) : 0;
+}
+
+// Solve the symmetric positive-definite system A x = b in place (Cholesky).
+// Returns false if A is not positive definite.
+static inline int nt_fit_cholesky_solve(double *a, double *b, int n) {
+    for (int j = 0; j < n; j++) {
+        double d = a[j * n + j];
+        for (int k = 0; k < j; k++) d -= a[j * n + k] * a[j * n + k];
+        if (d <= 0) return 0;
+        d            = sqrt(d);
+        a[j * n + j] = d;
+        for (int i = j + 1; i < n; i++) {
+            double v = a[i * n + j];
+            for (int k = 0; k < j; k++) v -= a[i * n + k] * a[j * n + k];
+            a[i * n + j] = v / d;
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        double v = b[i];
+        for (int k = 0; k < i; k++) v -= a[i * n + k] * b[k];
+        b[i] = v / a[i * n + i];
+    }
+    for (int i = n - 1; i >= 0; i--) {
+        double v = b[i];
+        for (int k = i + 1; k < n; k++) v -= a[k * n + i] * b[k];
+        b[i] = v / a[i * n + i];
+    }
+    return 1;
+}
+
+// Subtract the best-fit plane a + b*i + c*j from a g x g node grid. Straight
+// lines stay straight under an affine map, so this part of the field is not
+// determined by the strokes; removing it keeps the nodes small.
+static inline void nt_fit_remove_affine(int g, double *v) {
+    double mean = 0, si = 0, sj = 0, sii = 0;
+    for (int i = 0; i < g; i++) {
+        for (int j = 0; j < g; j++) mean += v[i * g + j];
+    }
+    mean /= g * g;
+    double c = (g - 1) / 2.0;
+    for (int i = 0; i < g; i++) {
+        for (int j = 0; j < g; j++) {
+            si += (i - c) * (v[i * g + j] - mean);
+            sj += (j - c) * (v[i * g + j] - mean);
+            sii += (i - c) * (i - c);
+        }
+    }
+    // The grid is symmetric, so the i and j slopes decouple.
+    for (int i = 0; i < g; i++) {
+        for (int j = 0; j < g; j++) v[i * g + j] -= mean + si / sii * (i - c) + sj / sii * (j - c);
+    }
+}
+
+// Fit the grid. `ex`/`ey` receive g*g int8 nodes. Returns 0 on success.
+static inline int nt_fit_lut(const nt_fit_stroke_t *s, int ns, const nt_fit_opts_t *opt, int8_t *ex, int8_t *ey) {
+    const int g = opt->grid, nn = g * g, n = 2 * nn;
+    if (!nt_lut_blob_grid_ok((uint8_t)g)) return -1;
+
+    double *a    = malloc(sizeof(double) * n * n);
+    double *b    = malloc(sizeof(double) * n);
+    double *f    = calloc(n, sizeof(double));  // current field: EX then EY
+    double *rbar = malloc(sizeof(double) * n);
+    char   *used = malloc(n);
+    int    *list = malloc(sizeof(int) * n);
+    long    total = 0;
+    for (int i = 0; i < ns; i++) total += s[i].n;
+    if (!a || !b || !f || !rbar || !used || !list || total == 0) {
+        free(a), free(b), free(f), free(rbar), free(used), free(list);
+        return -1;
+    }
+    int rc = 0;
+
+    for (int it = 0; it < opt->iterations && rc == 0; it++) {
+        memset(a, 0, sizeof(double) * n * n);
+        memset(b, 0, sizeof(double) * n);
+        for (int si = 0; si < ns; si++) {
+            const nt_fit_stroke_t *st = &s[si];
+            if (st->n < 3) continue;
+            double nx, ny;
+            nt_fit_line(st, g, it ? f : NULL, it ? f + nn : NULL, &nx, &ny);
+
+            // Row for point i: -n . E(p_i) = -n . p_i + c. Accumulate the raw
+            // sums, then subtract the stroke mean (which absorbs c).
+            memset(rbar, 0, sizeof(double) * n);
+            memset(used, 0, n);
+            int    nused = 0;
+            double tbar  = 0;
+            for (int i = 0; i < st->n; i++) {
+                int    idx[4], col[8];
+                double w[4], r[8];
+                nt_fit_weights(g, st->pts[i].x, st->pts[i].y, idx, w);
+                for (int k = 0; k < 4; k++) {
+                    col[k]     = idx[k];
+                    col[k + 4] = nn + idx[k];
+                    r[k]       = -nx * w[k];
+                    r[k + 4]   = -ny * w[k];
+                }
+                double t = -(nx * st->pts[i].x + ny * st->pts[i].y);
+                for (int p = 0; p < 8; p++) {
+                    for (int q = 0; q < 8; q++) a[col[p] * n + col[q]] += r[p] * r[q];
+                    b[col[p]] += r[p] * t;
+                    rbar[col[p]] += r[p];
+                    if (!used[col[p]]) used[col[p]] = 1, list[nused++] = col[p];
+                }
+                tbar += t;
+            }
+            double m = st->n;
+            for (int p = 0; p < nused; p++) {
+                int    u  = list[p];
+                double ru = rbar[list[p]];
+                for (int q = 0; q < nused; q++) a[u * n + list[q]] -= ru * rbar[list[q]] / m;
+                b[u] -= ru * tbar / m;
+            }
+        }
+
+        // Smoothness between grid neighbours and a small ridge, scaled to the
+        // number of points per node so the weights do not depend on how much
+        // was recorded.
+        double ls = opt->smooth * total / nn, lr = opt->ridge * total / nn;
+        for (int axis = 0; axis < 2; axis++) {
+            for (int i = 0; i < g; i++) {
+                for (int j = 0; j < g; j++) {
+                    int u = axis * nn + i * g + j;
+                    a[u * n + u] += lr;
+                    int nb[2] = {i + 1 < g ? u + g : -1, j + 1 < g ? u + 1 : -1};
+                    for (int k = 0; k < 2; k++) {
+                        int v = nb[k];
+                        if (v < 0) continue;
+                        a[u * n + u] += ls;
+                        a[v * n + v] += ls;
+                        a[u * n + v] -= ls;
+                        a[v * n + u] -= ls;
+                    }
+                }
+            }
+        }
+        if (!nt_fit_cholesky_solve(a, b, n)) {
+            rc = -1;
+            break;
+        }
+        for (int axis = 0; axis < 2; axis++) {
+            nt_fit_remove_affine(g, &b[axis * nn]);
+        }
+        for (int k = 0; k < n; k++) {
+            f[k] = b[k] > NT_LUT_BLOB_BOUND ? NT_LUT_BLOB_BOUND : b[k] < -NT_LUT_BLOB_BOUND ? -NT_LUT_BLOB_BOUND : b[k];
+        }
+    }
+    if (rc == 0) {
+        for (int k = 0; k < nn; k++) {
+            ex[k] = (int8_t)lround(f[k]);
+            ey[k] = (int8_t)lround(f[nn + k]);
+        }
+    }
+    free(a), free(b), free(f), free(rbar), free(used), free(list);
+    return rc;
+}
+
+// Pack fitted nodes into a sealed blob of NT_LUT_BLOB_SIZE(g) bytes.
+static inline void nt_fit_to_blob(int g, const int8_t *ex, const int8_t *ey, uint8_t *blob) {
+    memcpy(&blob[NT_LUT_BLOB_HEADER], ex, (size_t)g * g);
+    memcpy(&blob[NT_LUT_BLOB_HEADER + g * g], ey, (size_t)g * g);
+    nt_lut_blob_seal(blob, (uint8_t)g);
+}
@@ -0,0 +1,265 @@
+// Copyright 2026 ZSA Technology Labs, Inc <contact@zsa.io>
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// nt_replay: run a recorded trace through the firmware's frame pipeline
+// (navigator_trackpad_pipeline.c) on the host and dump the reports it sends.
+// Build from the module root, with the same -D options as the firmware:
+//   gcc -O2 -Wall -Inavigator_trackpad/tests/host -o nt_replay navigator_trackpad/tools/nt_replay.c -lm
+//
+// Usage: nt_replay [-m] [-b passes] trace.txt
+//
+// The trace is read line by line, in either of two forms:
+//   - a `libinput record` log of the trackpad. Its evdev lines
+//     ("- [sec, usec, type, code, value]") are collected into frames at each
+//     SYN_REPORT; slots 0 and 1 become the sensor's two fingers, mapped back
+//     from logical to sensor units. The firmware that recorded it should have
+//     had smoothing, prediction, LUT correction and rotation off, or they are
+//     applied twice.
+//   - raw report packets as read off the bus: hex bytes, optionally after a
+//     "<ms>:" timestamp. A line "-" is an empty read; replay it as a confirmed
+//     lift-off. Without timestamps the clock follows the packets' scan_time.
+// '#' starts a comment.
+//
+//   -m  replay in mouse-fallback mode instead of PTP
+//   -b  run the trace this many times with no output and print the pipeline's
+//       throughput in frames per second
+//
+// Output, one line per report: "<ms> PTP <16 hex bytes>" or
+// "<ms> MOUSE <buttons> <dx> <dy>", then a count of the reports sent and of
+// the PTP repeats held back (NAVIGATOR_TRACKPAD_PTP_SUPPRESS_STATIONARY) on
+// stderr.
+
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include "../navigator_trackpad_common.c"
+#include "../navigator_trackpad_pipeline.c"
+#include "../tests/host/mock_bus.h"
+
+// libinput / evdev codes
+#define EV_SYN 0
+#define EV_KEY 1
+#define EV_ABS 3
+#define BTN_LEFT 272
+#define ABS_MT_SLOT 47
+#define ABS_MT_POSITION_X 53
+#define ABS_MT_POSITION_Y 54
+#define ABS_MT_TRACKING_ID 57
+
+typedef struct {
+    cgen6_report_t frame;
+    uint32_t       now;
+} replay_frame_t;
+
+typedef struct {
+    replay_frame_t *frames;
+    int             count, cap;
+} trace_t;
+
+// evdev slot state carried between SYN_REPORTs
+typedef struct {
+    int32_t tracking_id[2];
+    int32_t x[2], y[2];
+    int32_t slot;
+    uint8_t buttons;
+} evdev_state_t;
+
+static int add_frame(trace_t *t, const cgen6_report_t *frame, uint32_t now) {
+    if (t->count == t->cap) {
+        t->cap    = t->cap ? t->cap * 2 : 4096;
+        t->frames = realloc(t->frames, sizeof(replay_frame_t) * t->cap);
+        if (!t->frames) return -1;
+    }
+    t->frames[t->count++] = (replay_frame_t){*frame, now};
+    return 0;
+}
+
+// Logical unit back to the sensor coordinate nt_transform_point() scales it
+// from (the smallest raw value that maps to it).
+static uint16_t unscale(int32_t v, uint16_t min, uint16_t max, uint32_t mult) {
+    if (v < 0) v = 0;
+    if (v > TRACKPAD_LOGICAL_MAX) v = TRACKPAD_LOGICAL_MAX;
+    uint32_t raw = min + (((uint32_t)v << 16) + mult - 1) / mult;
+    return raw > max ? max : (uint16_t)raw;
+}
+
+static int evdev_event(trace_t *t, evdev_state_t *ev, long sec, long usec, int type, int code, int32_t value) {
+    if (type == EV_ABS) {
+        if (code == ABS_MT_SLOT) ev->slot = value;
+        if (ev->slot < 0 || ev->slot > 1) return 0;
+        if (code == ABS_MT_TRACKING_ID) ev->tracking_id[ev->slot] = value;
+        if (code == ABS_MT_POSITION_X) ev->x[ev->slot] = value;
+        if (code == ABS_MT_POSITION_Y) ev->y[ev->slot] = value;
+    } else if (type == EV_KEY && code == BTN_LEFT) {
+        ev->buttons = value ? 0x01 : 0x00;
+    } else if (type == EV_SYN && code == 0) {
+        cgen6_report_t frame = {0};
+        for (int s = 0; s < 2; s++) {
+            if (ev->tracking_id[s] < 0) continue;
+            frame.fingers[s].tip        = 1;
+            frame.fingers[s].confidence = 1;
+            frame.fingers[s].id         = ev->tracking_id[s] & 0x3F;
+            frame.fingers[s].x          = unscale(ev->x[s], SENSOR_X_MIN, SENSOR_X_MAX, SENSOR_SCALE_X_MULT);
+            frame.fingers[s].y          = unscale(ev->y[s], SENSOR_Y_MIN, SENSOR_Y_MAX, SENSOR_SCALE_Y_MULT);
+            frame.contact_count++;
+        }
+        frame.buttons   = ev->buttons;
+        frame.scan_time = (uint16_t)(sec * 10000 + usec / 100);
+        return add_frame(t, &frame, (uint32_t)(sec * 1000 + usec / 1000));
+    }
+    return 0;
+}
+
+// "[<ms>:] <hex bytes>" or "[<ms>:] -". Anything else (blank lines, the
+// rest of a libinput log) is skipped.
+static bool is_raw_line(const char *line) {
+    const char *p = line + strspn(line, " \t");
+    const char *colon = strchr(p, ':');
+    if (colon) {
+        if (colon == p || strspn(p, "0123456789") != (size_t)(colon - p)) return false;
+        p = colon + 1;
+    }
+    p += strspn(p, " \t");
+    if (*p == '-') return strspn(p + 1, " \t\r\n") == strlen(p + 1);
+    return *p != '\0' && strspn(p, "0123456789abcdefABCDEF \t\r\n") == strlen(p);
+}
+
+// One raw packet line; *now carries the clock between lines.
+static int raw_line(trace_t *t, char *line, uint32_t *now, uint16_t *last_scan, bool *have_scan) {
+    bool  stamped = false;
+    char *colon   = strchr(line, ':');
+    if (colon) {
+        *now    = (uint32_t)strtoul(line, NULL, 10);
+        stamped = true;
+        line    = colon + 1;
+    }
+    line += strspn(line, " \t");
+    cgen6_report_t frame = {0};
+    if (*line == '-') {
+        if (!stamped) *now += 8;
+        return add_frame(t, &frame, *now);
+    }
+
+    uint8_t packet[CGEN6_MAX_PACKET_SIZE] = {0};
+    int     n                              = 0;
+    for (char *p = line; *p && n < CGEN6_MAX_PACKET_SIZE;) {
+        char        *end;
+        unsigned long b = strtoul(p, &end, 16);
+        if (end == p) break;
+        packet[n++] = (uint8_t)b;
+        p           = end;
+    }
+    if (n < 8) return 0;  // shorter than any report
+    if (!cgen6_decode_report(packet, &frame)) {
+        memset(&frame, 0, sizeof(frame));
+    } else if (!stamped) {
+        // scan_time is in 100 us ticks and wraps at 16 bits.
+        if (*have_scan) *now += (uint16_t)(frame.scan_time - *last_scan) / 10;
+        *last_scan = frame.scan_time;
+        *have_scan = true;
+    }
+    return add_frame(t, &frame, *now);
+}
+
+static int read_trace(FILE *f, trace_t *t) {
+    char          line[512];
+    evdev_state_t ev = {.tracking_id = {-1, -1}};
+    uint32_t      now = 0;
+    uint16_t      last_scan = 0;
+    bool          have_scan = false;
+    while (fgets(line, sizeof line, f)) {
+        char *hash = strchr(line, '#');
+        if (hash) *hash = '\0';
+        char *bracket = strchr(line, '[');
+        if (bracket) {
+            long sec, usec;
+            int  type, code, value;
+            if (sscanf(bracket, "[ %ld , %ld , %d , %d , %d ]", &sec, &usec, &type, &code, &value) == 5) {
+                if (evdev_event(t, &ev, sec, usec, type, code, value)) return -1;
+            }
+        } else if (is_raw_line(line)) {
+            if (raw_line(t, line, &now, &last_scan, &have_scan)) return -1;
+        }
+    }
+    return 0;
+}
+
+static void print_out(uint32_t now, const nt_pipeline_out_t *out) {
+    for (uint8_t i = 0; i < out->mouse_count; i++) {
+        printf("%u MOUSE %u %d %d\n", now, out->mouse[i].buttons, out->mouse[i].x, out->mouse[i].y);
+    }
+#if NAVIGATOR_TRACKPAD_SCROLL == TRUE
+    if (out->scroll) {
+        printf("%u SCROLL %d %d\n", now, out->scroll_v, out->scroll_h);
+    }
+#endif
+    if (out->ptp_send) {
+        printf("%u PTP", now);
+        for (int i = 0; i < NT_PIPELINE_PTP_REPORT_SIZE; i++) printf(" %02x", out->ptp[i]);
+        printf("\n");
+    }
+}
+
+int main(int argc, char **argv) {
+    uint8_t mode   = TRACKPAD_INPUT_MODE_PTP;
+    long    passes = 0;
+    int     c;
+    while ((c = getopt(argc, argv, "mb:")) != -1) {
+        switch (c) {
+            case 'm': mode = TRACKPAD_INPUT_MODE_MOUSE; break;
+            case 'b': passes = atol(optarg); break;
+            default: fprintf(stderr, "usage: %s [-m] [-b passes] trace.txt\n", argv[0]); return 2;
+        }
+    }
+    if (optind != argc - 1) {
+        fprintf(stderr, "usage: %s [-m] [-b passes] trace.txt\n", argv[0]);
+        return 2;
+    }
+
+    FILE *f = fopen(argv[optind], "r");
+    if (!f) {
+        perror(argv[optind]);
+        return 1;
+    }
+    trace_t t  = {0};
+    int     rc = read_trace(f, &t);
+    fclose(f);
+    if (rc || t.count == 0) {
+        fprintf(stderr, "%s: no frames read\n", argv[optind]);
+        return 1;
+    }
+
+    nt_pipeline_t     st;
+    nt_pipeline_out_t out;
+    if (passes <= 0) {
+        uint32_t ptp = 0, held = 0, mouse = 0;
+        nt_pipeline_init(&st, NAVIGATOR_TRACKPAD_LUT_CORRECTION == TRUE ? &NT_LUT_COMPILED : NULL);
+        for (int i = 0; i < t.count; i++) {
+            nt_pipeline_process(&st, &t.frames[i].frame, mode, t.frames[i].now, &out);
+            print_out(t.frames[i].now, &out);
+            ptp += out.ptp_send;
+            held += out.ptp_suppressed;
+            mouse += out.mouse_count;
+        }
+        fprintf(stderr, "%d frames: %u PTP reports (%u repeats held back), %u mouse reports\n", t.count, ptp, held,
+                mouse);
+        return 0;
+    }
+
+    struct timespec t0, t1;
+    uint32_t        sent = 0;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (long p = 0; p < passes; p++) {
+        nt_pipeline_init(&st, NAVIGATOR_TRACKPAD_LUT_CORRECTION == TRUE ? &NT_LUT_COMPILED : NULL);
+        for (int i = 0; i < t.count; i++) {
+            nt_pipeline_process(&st, &t.frames[i].frame, mode, t.frames[i].now, &out);
+            sent += out.ptp_send + out.mouse_count;
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double secs   = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+    double frames = (double)t.count * passes;
+    fprintf(stderr, "%d frames x %ld passes in %.3f s: %.0f frames/s (%u reports)\n", t.count, passes, secs,
+            frames / secs, sent);
+    return 0;
+}